@@ -0,0 +1,13 @@
+#extension GL_EXT_nonuniform_qualifier : require
+
+#define BINDLESS_INVALID_INDEX 0xFFFFFFFFu
+
+layout (set = 0, binding = 0) uniform texture2D bindlessTextures[];
+layout (set = 0, binding = 1) uniform sampler bindlessSamplers[];
+layout (set = 0, binding = 2) readonly buffer BindlessStorageBuffer {
+	uint words[];
+} bindlessBuffers[];
+
+vec4 sampleBindless(uint textureIndex, uint samplerIndex, vec2 uv) {
+	return texture(sampler2D(bindlessTextures[nonuniformEXT(textureIndex)], bindlessSamplers[nonuniformEXT(samplerIndex)]), uv);
+}
@@ -0,0 +1,19 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "Bindless.glsl"
+
+//shader input
+layout (location = 0) in vec3 inColor;
+layout (location = 1) in vec2 inUV;
+layout (location = 2) flat in uint inTextureIndex;
+layout (location = 3) flat in uint inSamplerIndex;
+
+//output write
+layout (location = 0) out vec4 outFragColor;
+
+void main()
+{
+	//tint the vertex color with the instance texture
+	outFragColor = vec4(inColor, 1.0f) * sampleBindless(inTextureIndex, inSamplerIndex, inUV);
+}
\ No newline at end of file
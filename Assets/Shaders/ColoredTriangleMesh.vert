@@ -3,35 +3,57 @@
 
 layout (location = 0) out vec3 outColor;
 layout (location = 1) out vec2 outUV;
+layout (location = 2) flat out uint outTextureIndex;
+layout (location = 3) flat out uint outSamplerIndex;
 
 struct Vertex {
-
 	vec3 position;
 	float uv_x;
 	vec3 normal;
 	float uv_y;
 	vec4 color;
-}; 
+};
 
-layout(buffer_reference, std430) readonly buffer VertexBuffer{ 
+layout(buffer_reference, std430) readonly buffer VertexBuffer{
 	Vertex vertices[];
 };
 
+struct Instance {
+	mat4 model;
+	uint textureIndex;
+	uint samplerIndex;
+};
+
+layout(buffer_reference, std430) readonly buffer InstanceBuffer{
+	Instance instances[];
+};
+
+layout(set = 1, binding = 0) uniform SceneData{
+	mat4 view;
+	mat4 proj;
+	mat4 viewproj;
+} sceneData;
+
 //push constants block
 layout( push_constant ) uniform constants
-{	
-	mat4 render_matrix;
+{
 	VertexBuffer vertexBuffer;
+	InstanceBuffer instanceBuffer;
 } PushConstants;
 
-void main() 
-{	
+void main()
+{
 	//load vertex data from device adress
 	Vertex v = PushConstants.vertexBuffer.vertices[gl_VertexIndex];
 
+	//load per-instance data, gl_InstanceIndex includes firstInstance
+	Instance instance = PushConstants.instanceBuffer.instances[gl_InstanceIndex];
+
 	//output data
-	gl_Position = PushConstants.render_matrix *vec4(v.position, 1.0f);
+	gl_Position = sceneData.viewproj * instance.model * vec4(v.position, 1.0f);
 	outColor = v.color.xyz;
 	outUV.x = v.uv_x;
 	outUV.y = v.uv_y;
+	outTextureIndex = instance.textureIndex;
+	outSamplerIndex = instance.samplerIndex;
 }
\ No newline at end of file
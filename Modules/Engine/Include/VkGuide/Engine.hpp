@@ -2,10 +2,30 @@
 
 #include <VkGuide/Defines.hpp>
 #include <VkGuide/VkDescriptors.hpp>
+#include <VkGuide/VkBindless.hpp>
+#include <VkGuide/VkDeletionQueue.hpp>
+#include <VkGuide/VkFrameAllocator.hpp>
+#include <VkGuide/VkFrameArena.hpp>
 #include <VkGuide/VkTypes.hpp>
 #include <VkGuide/VkLoader.hpp>
+#include <VkGuide/VkJobs.hpp>
+#include <VkGuide/VkMemoryTelemetry.hpp>
+#include <VkGuide/VkRenderList.hpp>
+#include <VkGuide/VkRenderGraph.hpp>
+#include <VkGuide/VkResourcePools.hpp>
+#include <VkGuide/VkPipelineCache.hpp>
+#include <VkGuide/VkPipelineCompiler.hpp>
+#include <VkGuide/VkPipelineVariants.hpp>
+#include <VkGuide/VkPipelineLibrary.hpp>
+#include <VkGuide/VkDynamicState.hpp>
+#include <VkGuide/VkShaderWatcher.hpp>
+#include <VkGuide/VkSimulation.hpp>
+#include <VkGuide/VkShaderArchive.hpp>
+#include <VkGuide/VkTextures.hpp>
+#include <VkGuide/VkTextureStreaming.hpp>
 
 constexpr std::uint32_t FRAME_OVERLAP{2};
+constexpr std::uint32_t MAX_INSTANCES_PER_FRAME{16384};
 
 class DeletionQueue {
    public:
@@ -38,7 +58,9 @@ struct FrameData {
     VkSemaphore RenderSemaphore;
     VkFence RenderFence;
 
-    DeletionQueue DeletionQueue;
+    DescriptorAllocatorGrowable FrameDescriptors;
+    FrameAllocator LinearAllocator;
+    FrameArena Arena;
 };
 
 struct ComputePushConstants {
@@ -55,6 +77,19 @@ struct ComputeEffect {
     ComputePushConstants Data;
 };
 
+struct MeshUploadStats {
+    std::uint32_t DirectBufferCount;
+    std::uint32_t StagedBufferCount;
+    VkDeviceSize DirectBytes;
+    VkDeviceSize StagedBytes;
+};
+
+struct ReloadablePipeline {
+    std::vector<std::string> ShaderPaths;
+    std::function<VkPipeline(std::span<const VkShaderModule> shaderModules)> Build;
+    VkPipeline *Target;
+};
+
 class VulkanEngine {
    public:
     VulkanEngine(const VulkanEngine &) = delete;
@@ -77,6 +112,7 @@ class VulkanEngine {
     void initSwapchain();
     void initCommands();
     void initSyncStructures();
+    void initFrameAllocators();
     void initDescriptors();
     void initPipelines();
     void initBackgroundPipelines();
@@ -84,25 +120,49 @@ class VulkanEngine {
     void initMeshPipeline();
     void initImGui();
     void initDefaultData();
+    void initShaderHotReload();
+    void initSimulation();
+
+    void registerReloadablePipeline(ReloadablePipeline &&reloadable);
+    void pollShaderChanges();
+    void recompileShader(const std::filesystem::path &sourcePath);
+    void reloadPipeline(std::uint32_t index);
+    void applyReloadedPipelines();
 
     void createSwapchain(std::uint32_t width, std::uint32_t height);
     void destroySwapchain();
     void resizeSwapchain();
 
+    void clearBackground(VkCommandBuffer commandBuffer);
     void drawBackground(VkCommandBuffer commandBuffer);
     void drawImGui(VkCommandBuffer commandBuffer, VkImageView targetImageView);
-    void drawGeometry(VkCommandBuffer commandBuffer);
+    void drawGeometry(VkCommandBuffer commandBuffer, VkImageView depthImageView);
 
     void immediateSubmit(std::function<void(VkCommandBuffer commandBuffer)> &&function);
 
     void destroyBuffer(const AllocatedBuffer &buffer);
+    void destroyImage(const AllocatedImage &image);
 
     FrameData &getCurrentFrame();
 
-    AllocatedBuffer createBuffer(std::size_t allocationSize, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage);
+    bool writeMappedBuffer(const AllocatedBuffer &buffer, const void *data, std::size_t size);
+    AllocatedBuffer createBuffer(std::size_t allocationSize, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage, MemoryCategory category, VmaAllocationCreateFlags flags = 0);
+
+    AllocatedImage allocateImage(VkExtent3D extent, VkFormat format, VkImageUsageFlags usage, std::uint32_t mipLevels);
+    std::vector<std::optional<DecodedTexture>> loadTextures(std::span<const TextureSource> sources, bool buildMipChain);
+    std::vector<AllocatedImage> uploadTextures(std::span<const std::optional<DecodedTexture>> textures, VkImageUsageFlags usage, bool mipmapped);
+
+    void unloadScene(LoadedScene &scene);
 
    public:
-    GPUMeshBuffers createMesh(const std::span<std::uint32_t> &indices, const std::span<Vertex> &vertices);
+    MeshHandle createMesh(const std::span<std::uint32_t> &indices, const std::span<Vertex> &vertices);
+
+    ImageHandle createImage(VkExtent3D extent, VkFormat format, VkImageUsageFlags usage, bool mipmapped = false);
+    ImageHandle createImage(const void *data, VkExtent3D extent, VkFormat format, VkImageUsageFlags usage, bool mipmapped = false);
+    std::vector<ImageHandle> createTextures(std::span<const TextureSource> sources);
+    std::vector<std::uint32_t> createStreamedTextures(std::span<const TextureSource> sources);
+
+    std::uint32_t getSamplerIndex(const SamplerKey &key);
 
    private:
     static VulkanEngine g_VkEngine;
@@ -120,6 +180,7 @@ class VulkanEngine {
     VkPhysicalDevice m_PhysicalDevice{VK_NULL_HANDLE};
     VkDevice m_Device{VK_NULL_HANDLE};
     VkSurfaceKHR m_Surface{VK_NULL_HANDLE};
+    DeviceCapabilities m_DeviceCapabilities{};
 
     VkSwapchainKHR m_Swapchain{VK_NULL_HANDLE};
     VkFormat m_SwapchainImageFormat{VK_FORMAT_UNDEFINED};
@@ -136,16 +197,32 @@ class VulkanEngine {
     DeletionQueue m_MainDeletionQueue{};
 
     VmaAllocator m_Allocator{nullptr};
+    MemoryTelemetry m_MemoryTelemetry{};
+    DeferredDeletionQueue m_DeferredDeletionQueue{};
+    ResourcePools m_ResourcePools{};
 
     AllocatedImage m_DrawImage{};
-    AllocatedImage m_DepthImage{};
+    VkFormat m_DepthFormat{VK_FORMAT_D32_SFLOAT};
     VkExtent2D m_DrawExtent{};
     float m_RenderScale{1.0f};
 
-    DescriptorAllocator m_GlobalDescriptorAllocator{};
+    BindlessHeap m_BindlessHeap{};
 
     VkDescriptorSetLayout m_DrawImageDescriptorLayout{VK_NULL_HANDLE};
-    VkDescriptorSet m_DrawImageDescriptors{VK_NULL_HANDLE};
+    VkDescriptorSetLayout m_SceneDataDescriptorLayout{VK_NULL_HANDLE};
+
+    PipelineCache m_PipelineCache{};
+    PipelineCompiler m_PipelineCompiler{};
+    PipelineVariantCache m_PipelineVariants{};
+    PipelineLibraryLinker m_PipelineLibraryLinker{};
+    DynamicStateTracker m_DynamicStateTracker{};
+    ShaderArchive m_ShaderArchive{};
+    ShaderModuleCache m_ShaderModuleCache{};
+
+    ShaderWatcher m_ShaderWatcher{};
+    std::vector<ReloadablePipeline> m_ReloadablePipelines{};
+    std::mutex m_ReloadMutex{};
+    std::vector<std::pair<VkPipeline *, VkPipeline>> m_ReloadedPipelines{};
 
     VkPipelineLayout m_GradientPipelineLayout{VK_NULL_HANDLE};
     VkPipeline m_GradientPipeline{VK_NULL_HANDLE};
@@ -159,11 +236,34 @@ class VulkanEngine {
 
     VkPipelineLayout m_TrianglePipelineLayout{VK_NULL_HANDLE};
     VkPipeline m_TrianglePipeline{VK_NULL_HANDLE};
+    PipelineDynamicState m_TriangleDynamicState{};
 
     VkPipelineLayout m_MeshPipelineLayout{VK_NULL_HANDLE};
     VkPipeline m_MeshPipeline{VK_NULL_HANDLE};
+    PipelineDynamicState m_MeshDynamicState{};
+
+    MeshHandle m_Rectangle{};
+    MeshUploadStats m_MeshUploadStats{};
+
+    CompressedFormatSupport m_CompressedFormatSupport{};
+    SamplerCache m_SamplerCache{};
+    TextureStats m_TextureStats{};
+    TextureStreamer m_TextureStreamer{};
+
+    ImageHandle m_WhiteImage{};
+    ImageHandle m_ErrorCheckerboardImage{};
+    VkSampler m_DefaultSamplerLinear{VK_NULL_HANDLE};
+    VkSampler m_DefaultSamplerNearest{VK_NULL_HANDLE};
+    std::uint32_t m_WhiteImageIndex{BINDLESS_INVALID_INDEX};
+    std::uint32_t m_DefaultSamplerIndex{BINDLESS_INVALID_INDEX};
+
+    LoadedScene m_Scene{};
+    Simulation m_Simulation{};
+
+    RenderList m_RenderList{};
+    DrawStats m_DrawStats{};
 
-    GPUMeshBuffers m_Rectangle;
+    RenderGraph m_RenderGraph{};
 
-    std::vector<std::shared_ptr<MeshAsset>> m_TestMeshes{};
+    JobSystem m_JobSystem{};
 };
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+
+#include <memory_resource>
+#include <unordered_map>
+
+struct BarrierScope {
+    VkPipelineStageFlags2 Stage;
+    VkAccessFlags2 Access;
+};
+
+constexpr BarrierScope BARRIER_SCOPE_NONE{VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE};
+constexpr BarrierScope BARRIER_SCOPE_TRANSFER_READ{VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT};
+constexpr BarrierScope BARRIER_SCOPE_TRANSFER_WRITE{VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT};
+constexpr BarrierScope BARRIER_SCOPE_SHADER_SAMPLED{VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT};
+
+class BarrierBuilder {
+   public:
+    explicit BarrierBuilder(std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+    ~BarrierBuilder() = default;
+
+    void trackImage(VkImage image, VkImageAspectFlags aspect, std::uint32_t mipLevels = 1, VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED);
+    void untrackImage(VkImage image);
+    VkImageLayout getLayout(VkImage image, std::uint32_t mipLevel = 0) const;
+
+    BarrierBuilder &transitionImage(VkImage image, const BarrierScope &src, const BarrierScope &dst, VkImageLayout newLayout);
+    BarrierBuilder &transitionImageMips(VkImage image, std::uint32_t baseMipLevel, std::uint32_t mipCount, const BarrierScope &src, const BarrierScope &dst, VkImageLayout newLayout);
+    BarrierBuilder &bufferBarrier(VkBuffer buffer, const BarrierScope &src, const BarrierScope &dst, VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
+
+    void flush(VkCommandBuffer commandBuffer);
+
+    std::uint32_t getPendingCount() const;
+
+   private:
+    struct TrackedImage {
+        VkImageAspectFlags Aspect;
+        std::pmr::vector<VkImageLayout> Layouts;
+    };
+
+   private:
+    std::pmr::unordered_map<VkImage, TrackedImage> m_Images;
+
+    std::pmr::vector<VkImageMemoryBarrier2> m_ImageBarriers;
+    std::pmr::vector<VkBufferMemoryBarrier2> m_BufferBarriers;
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+#include <VkGuide/VkDescriptors.hpp>
+
+#include <mutex>
+
+constexpr std::uint32_t BINDLESS_SAMPLED_IMAGE_BINDING{0};
+constexpr std::uint32_t BINDLESS_SAMPLER_BINDING{1};
+constexpr std::uint32_t BINDLESS_STORAGE_BUFFER_BINDING{2};
+
+constexpr std::uint32_t BINDLESS_MAX_SAMPLED_IMAGES{16384};
+constexpr std::uint32_t BINDLESS_MAX_SAMPLERS{256};
+constexpr std::uint32_t BINDLESS_MAX_STORAGE_BUFFERS{16384};
+
+constexpr std::uint32_t BINDLESS_INVALID_INDEX{~0U};
+
+class BindlessIndexAllocator {
+   public:
+    BindlessIndexAllocator() = default;
+    ~BindlessIndexAllocator() = default;
+
+    void init(std::uint32_t capacity);
+
+    std::uint32_t allocate();
+    void release(std::uint32_t index, std::uint64_t frameNumber);
+    void recycle(std::uint64_t completedFrameNumber);
+
+    std::uint32_t getCapacity() const;
+    std::uint32_t getUsedCount() const;
+
+   private:
+    struct RetiredIndex {
+        std::uint32_t Index;
+        std::uint64_t FrameNumber;
+    };
+
+   private:
+    std::uint32_t m_Capacity{0};
+    std::uint32_t m_NextIndex{0};
+    std::vector<std::uint32_t> m_FreeIndices{};
+    std::deque<RetiredIndex> m_RetiredIndices{};
+};
+
+class BindlessHeap {
+   public:
+    BindlessHeap() = default;
+    ~BindlessHeap() = default;
+
+    void init(VkDevice device, VkPhysicalDevice physicalDevice, std::uint32_t framesInFlight);
+    void destroy();
+
+    void beginFrame(std::uint64_t frameNumber);
+    void flush();
+
+    std::uint32_t addSampledImage(VkImageView imageView, VkImageLayout imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    std::uint32_t addSampler(VkSampler sampler);
+    std::uint32_t addStorageBuffer(VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
+
+    void removeSampledImage(std::uint32_t index);
+    void removeSampler(std::uint32_t index);
+    void removeStorageBuffer(std::uint32_t index);
+
+    void bind(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout layout, std::uint32_t setIndex = 0) const;
+
+    VkDescriptorSetLayout getLayout() const;
+    VkDescriptorSet getSet() const;
+
+    std::uint32_t getSampledImageCount() const;
+    std::uint32_t getSamplerCount() const;
+    std::uint32_t getStorageBufferCount() const;
+
+   private:
+    std::uint32_t allocateIndex(BindlessIndexAllocator &allocator, const char *name);
+
+   private:
+    VkDevice m_Device{VK_NULL_HANDLE};
+    VkDescriptorPool m_Pool{VK_NULL_HANDLE};
+    VkDescriptorSetLayout m_Layout{VK_NULL_HANDLE};
+    VkDescriptorSet m_Set{VK_NULL_HANDLE};
+
+    std::uint32_t m_FramesInFlight{0};
+    std::uint64_t m_FrameNumber{0};
+
+    mutable std::mutex m_Mutex{};
+    DescriptorWriter m_Writer{};
+    BindlessIndexAllocator m_SampledImages{};
+    BindlessIndexAllocator m_Samplers{};
+    BindlessIndexAllocator m_StorageBuffers{};
+};
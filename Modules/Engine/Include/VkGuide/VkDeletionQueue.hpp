@@ -0,0 +1,62 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+#include <VkGuide/VkTypes.hpp>
+
+class MemoryTelemetry;
+
+template <typename T>
+struct DeferredDeletion {
+    T Handle;
+    std::uint64_t FrameNumber;
+};
+
+struct DeferredImage {
+    VkImage Image;
+    VkImageView View;
+    VmaAllocation Allocation;
+};
+
+struct DeferredBuffer {
+    VkBuffer Buffer;
+    VmaAllocation Allocation;
+};
+
+struct DeferredDeletionStats {
+    std::uint32_t PendingCount;
+    std::uint32_t DestroyedCount;
+    std::uint32_t FunctionCount;
+};
+
+class DeferredDeletionQueue {
+   public:
+    DeferredDeletionQueue() = default;
+    ~DeferredDeletionQueue() = default;
+
+    void init(VkDevice device, VmaAllocator allocator, MemoryTelemetry *memoryTelemetry, std::uint32_t framesInFlight);
+    void destroy();
+
+    void pushPipeline(VkPipeline pipeline, std::uint64_t frameNumber);
+    void pushImageView(VkImageView view, std::uint64_t frameNumber);
+    void pushImage(const AllocatedImage &image, std::uint64_t frameNumber);
+    void pushBuffer(const AllocatedBuffer &buffer, std::uint64_t frameNumber);
+    void pushFunction(std::function<void()> &&function, std::uint64_t frameNumber);
+
+    void flush(std::uint64_t frameNumber);
+
+    const DeferredDeletionStats &getStats() const;
+
+   private:
+    VkDevice m_Device{VK_NULL_HANDLE};
+    VmaAllocator m_Allocator{nullptr};
+    MemoryTelemetry *m_MemoryTelemetry{nullptr};
+    std::uint32_t m_FramesInFlight{0};
+
+    std::vector<DeferredDeletion<VkPipeline>> m_Pipelines{};
+    std::vector<DeferredDeletion<VkImageView>> m_ImageViews{};
+    std::vector<DeferredDeletion<DeferredImage>> m_Images{};
+    std::vector<DeferredDeletion<DeferredBuffer>> m_Buffers{};
+    std::vector<DeferredDeletion<std::function<void()>>> m_Functions{};
+
+    DeferredDeletionStats m_Stats{};
+};
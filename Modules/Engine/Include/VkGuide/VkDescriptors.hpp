@@ -7,7 +7,7 @@ class DescriptorLayoutBuilder {
     DescriptorLayoutBuilder() = default;
     ~DescriptorLayoutBuilder() = default;
 
-    void addBinding(std::uint32_t binding, VkDescriptorType type);
+    void addBinding(std::uint32_t binding, VkDescriptorType type, std::uint32_t count = 1);
     void clear();
 
     VkDescriptorSetLayout build(VkDevice device, VkShaderStageFlags shaderStages, void *pNext = nullptr, VkDescriptorSetLayoutCreateFlags flags = 0);
@@ -16,6 +16,25 @@ class DescriptorLayoutBuilder {
     std::vector<VkDescriptorSetLayoutBinding> m_Bindings;
 };
 
+class DescriptorWriter {
+   public:
+    DescriptorWriter() = default;
+    ~DescriptorWriter() = default;
+
+    void writeImage(VkDescriptorSet set, std::uint32_t binding, VkImageView imageView, VkSampler sampler, VkImageLayout layout, VkDescriptorType type, std::uint32_t arrayElement = 0);
+    void writeBuffer(VkDescriptorSet set, std::uint32_t binding, VkBuffer buffer, VkDeviceSize size, VkDeviceSize offset, VkDescriptorType type, std::uint32_t arrayElement = 0);
+
+    void clear();
+    void flush(VkDevice device);
+
+    std::uint32_t getPendingCount() const;
+
+   private:
+    std::deque<VkDescriptorImageInfo> m_ImageInfos{};
+    std::deque<VkDescriptorBufferInfo> m_BufferInfos{};
+    std::vector<VkWriteDescriptorSet> m_Writes{};
+};
+
 class DescriptorAllocator {
    public:
     struct PoolSizeRatio {
@@ -35,4 +54,31 @@ class DescriptorAllocator {
 
    private:
     VkDescriptorPool m_Pool{VK_NULL_HANDLE};
+};
+
+class DescriptorAllocatorGrowable {
+   public:
+    using PoolSizeRatio = DescriptorAllocator::PoolSizeRatio;
+
+   public:
+    DescriptorAllocatorGrowable() = default;
+    ~DescriptorAllocatorGrowable() = default;
+
+    void init(VkDevice device, std::uint32_t initialSets, std::span<const PoolSizeRatio> poolRatios);
+    void clearPools(VkDevice device);
+    void destroyPools(VkDevice device);
+
+    VkDescriptorSet allocate(VkDevice device, VkDescriptorSetLayout layout, void *pNext = nullptr);
+
+    std::uint32_t getPoolCount() const;
+
+   private:
+    VkDescriptorPool getPool(VkDevice device);
+    VkDescriptorPool createPool(VkDevice device, std::uint32_t setCount) const;
+
+   private:
+    std::vector<PoolSizeRatio> m_Ratios{};
+    std::vector<VkDescriptorPool> m_FullPools{};
+    std::vector<VkDescriptorPool> m_ReadyPools{};
+    std::uint32_t m_SetsPerPool{0};
 };
\ No newline at end of file
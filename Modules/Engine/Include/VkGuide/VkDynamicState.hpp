@@ -0,0 +1,36 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+#include <VkGuide/VkPipelines.hpp>
+
+class DynamicStateTracker {
+   public:
+    DynamicStateTracker() = default;
+    ~DynamicStateTracker() = default;
+
+    void init(VkDevice device, DynamicStateFlags supportedFlags);
+
+    void begin(VkCommandBuffer commandBuffer);
+    void apply(const PipelineDynamicState &state);
+
+    DynamicStateFlags getSupportedFlags() const;
+    std::uint32_t getSetCount() const;
+    std::uint32_t getSkippedCount() const;
+
+   private:
+    template <typename T, typename Function>
+    void set(T &current, const T &value, Function &&function);
+
+   private:
+    DynamicStateFlags m_SupportedFlags{0};
+    PFN_vkCmdSetColorBlendEnableEXT m_CmdSetColorBlendEnable{nullptr};
+    PFN_vkCmdSetColorBlendEquationEXT m_CmdSetColorBlendEquation{nullptr};
+    PFN_vkCmdSetColorWriteMaskEXT m_CmdSetColorWriteMask{nullptr};
+
+    VkCommandBuffer m_CommandBuffer{VK_NULL_HANDLE};
+    PipelineDynamicState m_State{};
+    bool m_IsValid{false};
+
+    std::uint32_t m_SetCount{0};
+    std::uint32_t m_SkippedCount{0};
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+#include <VkGuide/VkTypes.hpp>
+
+class MemoryTelemetry;
+
+constexpr VkDeviceSize FRAME_ALLOCATOR_CAPACITY{4 * 1024 * 1024};
+constexpr VkDeviceSize FRAME_ALLOCATOR_MIN_ALIGNMENT{16};
+
+struct FrameAllocation {
+    void *Data;
+    VkBuffer Buffer;
+    VkDeviceSize Offset;
+    VkDeviceSize Size;
+    VkDeviceAddress Address;
+};
+
+struct FrameAllocatorStats {
+    VkDeviceSize Capacity;
+    VkDeviceSize UsedBytes;
+    VkDeviceSize PeakBytes;
+    std::uint32_t AllocationCount;
+    std::uint32_t FailedCount;
+    bool IsDeviceLocal;
+};
+
+class FrameAllocator {
+   public:
+    FrameAllocator() = default;
+    ~FrameAllocator() = default;
+
+    void init(VkDevice device, VmaAllocator allocator, MemoryTelemetry *memoryTelemetry, VkDeviceSize capacity, VkDeviceSize alignment);
+    void destroy();
+
+    void reset();
+    std::optional<FrameAllocation> allocate(VkDeviceSize size, VkDeviceSize alignment = 0);
+    void flush();
+
+    template <typename T>
+    std::optional<FrameAllocation> allocateArray(std::uint32_t count) {
+        return allocate(count * sizeof(T), alignof(T));
+    }
+
+    VkBuffer getBuffer() const;
+    const FrameAllocatorStats &getStats() const;
+
+   private:
+    VmaAllocator m_Allocator{nullptr};
+    MemoryTelemetry *m_MemoryTelemetry{nullptr};
+
+    AllocatedBuffer m_Buffer{};
+    VkDeviceAddress m_Address{0};
+    VkDeviceSize m_Alignment{FRAME_ALLOCATOR_MIN_ALIGNMENT};
+    VkDeviceSize m_Offset{0};
+
+    FrameAllocatorStats m_Stats{};
+};
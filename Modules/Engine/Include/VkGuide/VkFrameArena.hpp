@@ -0,0 +1,72 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+
+#include <memory_resource>
+
+constexpr std::size_t FRAME_ARENA_CAPACITY{256 * 1024};
+constexpr std::size_t FRAME_ARENA_WORKER_CAPACITY{64 * 1024};
+
+struct FrameArenaStats {
+    std::size_t Capacity;
+    std::size_t UsedBytes;
+    std::size_t HighWaterMark;
+    std::uint32_t AllocationCount;
+    std::uint32_t HeapAllocationCount;
+};
+
+class LinearArena : public std::pmr::memory_resource {
+   public:
+    LinearArena() = default;
+    ~LinearArena() override = default;
+
+    LinearArena(const LinearArena &) = delete;
+    LinearArena &operator=(const LinearArena &) = delete;
+
+    void init(std::size_t capacity);
+    void destroy();
+
+    void reset();
+
+    const FrameArenaStats &getStats() const;
+
+   protected:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+   private:
+    struct Block {
+        std::unique_ptr<std::byte[]> Data;
+        std::size_t Size;
+    };
+
+   private:
+    void pushBlock(std::size_t size);
+
+   private:
+    std::vector<Block> m_Blocks{};
+    std::size_t m_Offset{0};
+    std::size_t m_RetiredBytes{0};
+
+    FrameArenaStats m_Stats{};
+};
+
+class FrameArena {
+   public:
+    FrameArena() = default;
+    ~FrameArena() = default;
+
+    void init(std::uint32_t workerCount, std::size_t capacity = FRAME_ARENA_CAPACITY, std::size_t workerCapacity = FRAME_ARENA_WORKER_CAPACITY);
+    void destroy();
+
+    void reset();
+
+    std::pmr::memory_resource *getResource();
+    std::pmr::memory_resource *getWorkerResource(std::uint32_t workerIndex);
+
+    FrameArenaStats getStats() const;
+
+   private:
+    std::vector<std::unique_ptr<LinearArena>> m_Arenas{};
+};
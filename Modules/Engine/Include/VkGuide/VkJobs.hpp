@@ -0,0 +1,73 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+constexpr std::uint32_t JOB_GROUP_NONE{0};
+constexpr std::uint32_t JOB_WORKER_INDEX_NONE{~0U};
+
+struct Job {
+    std::function<void()> Function;
+    std::uint32_t Group;
+};
+
+class JobSystem {
+   public:
+    JobSystem() = default;
+    ~JobSystem() = default;
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    void init(std::uint32_t workerCount = 0);
+    void shutdown();
+
+    template <typename Function>
+    std::future<std::invoke_result_t<Function>> submit(Function &&function, std::uint32_t group = JOB_GROUP_NONE) {
+        using ResultType = std::invoke_result_t<Function>;
+
+        std::shared_ptr<std::packaged_task<ResultType()>> task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<Function>(function));
+        std::future<ResultType> future = task->get_future();
+
+        if (m_Workers.empty()) {
+            (*task)();
+            return future;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{m_Mutex};
+            m_Jobs.emplace_back(Job{.Function = [task]() { (*task)(); }, .Group = group});
+        }
+        m_Condition.notify_one();
+
+        return future;
+    }
+
+    void parallelFor(std::uint32_t count, std::uint32_t batchSize, const std::function<void(std::uint32_t begin, std::uint32_t end)> &function);
+
+    // Groups let a waiting thread help with its own jobs without picking up unrelated long-running work.
+    std::uint32_t createGroup();
+    bool runPendingJob(std::uint32_t group);
+
+    std::uint32_t getWorkerCount() const;
+
+    // 0 on the thread that called init(), 1..N on pool workers and JOB_WORKER_INDEX_NONE on any other thread.
+    static std::uint32_t GetCurrentWorkerIndex();
+
+   private:
+    void workerLoop(std::uint32_t workerIndex);
+
+   private:
+    std::vector<std::thread> m_Workers{};
+    std::deque<Job> m_Jobs{};
+    std::mutex m_Mutex{};
+    std::condition_variable m_Condition{};
+    bool m_Running{false};
+    std::atomic<std::uint32_t> m_NextGroup{JOB_GROUP_NONE + 1};
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+#include <VkGuide/VkTypes.hpp>
+
+#include <filesystem>
+
+constexpr std::array<std::uint8_t, 12> KTX2_IDENTIFIER{0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+constexpr std::uint64_t KTX2_LEVEL_ALIGNMENT{16};
+
+struct Ktx2Header {
+    std::array<std::uint8_t, 12> Identifier;
+    std::uint32_t Format;
+    std::uint32_t TypeSize;
+    std::uint32_t PixelWidth;
+    std::uint32_t PixelHeight;
+    std::uint32_t PixelDepth;
+    std::uint32_t LayerCount;
+    std::uint32_t FaceCount;
+    std::uint32_t LevelCount;
+    std::uint32_t SupercompressionScheme;
+    std::uint32_t DfdByteOffset;
+    std::uint32_t DfdByteLength;
+    std::uint32_t KvdByteOffset;
+    std::uint32_t KvdByteLength;
+    std::uint64_t SgdByteOffset;
+    std::uint64_t SgdByteLength;
+};
+
+struct Ktx2LevelIndex {
+    std::uint64_t ByteOffset;
+    std::uint64_t ByteLength;
+    std::uint64_t UncompressedByteLength;
+};
+
+static_assert(sizeof(Ktx2Header) == 80);
+static_assert(sizeof(Ktx2LevelIndex) == 24);
+
+namespace vkutils {
+    bool IsKtx2(std::span<const std::uint8_t> bytes);
+
+    std::optional<DecodedTexture> ReadKtx2(std::span<const std::uint8_t> bytes);
+    bool WriteKtx2(const std::filesystem::path &filePath, const DecodedTexture &texture);
+}  // namespace vkutils
@@ -2,19 +2,35 @@
 
 #include <VkGuide/Defines.hpp>
 #include <VkGuide/VkTypes.hpp>
+#include <VkGuide/VkResourcePools.hpp>
+#include <VkGuide/VkScene.hpp>
 #include <unordered_map>
 #include <filesystem>
 #include <string>
 
+constexpr std::int32_t SURFACE_NO_IMAGE{-1};
+constexpr std::int32_t SURFACE_NO_SAMPLER{-1};
+
 struct GeoSurface {
     std::uint32_t StartIndex;
     std::uint32_t Count;
+    std::int32_t ImageIndex;
+    std::int32_t SamplerIndex;
+    float UvDensity;
 };
 
 struct MeshAsset {
     std::string Name;
     std::vector<GeoSurface> Surfaces;
-    GPUMeshBuffers MeshBuffers;
+    MeshHandle Mesh;
+};
+
+struct LoadedScene {
+    std::vector<std::shared_ptr<MeshAsset>> Meshes;
+    std::vector<std::uint32_t> Textures;
+    std::vector<std::uint32_t> Samplers;
+    SceneGraph Graph;
 };
 
-std::optional<std::vector<std::shared_ptr<MeshAsset>>> loadGltfMeshes(class VulkanEngine *engine, std::filesystem::path filePath);
\ No newline at end of file
+std::optional<std::vector<std::shared_ptr<MeshAsset>>> loadGltfMeshes(class VulkanEngine *engine, std::filesystem::path filePath);
+std::optional<LoadedScene> loadGltfScene(class VulkanEngine *engine, std::filesystem::path filePath);
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+
+#include <filesystem>
+#include <mutex>
+
+constexpr const char *MEMORY_STATS_PATH{"MemoryStats.json"};
+
+enum class MemoryCategory : std::uint32_t {
+    Mesh,
+    Texture,
+    RenderTarget,
+    Staging,
+    Frame,
+    Count,
+};
+
+constexpr std::size_t MEMORY_CATEGORY_COUNT{(std::size_t)MemoryCategory::Count};
+
+struct MemoryCategoryStats {
+    std::uint32_t AllocationCount;
+    VkDeviceSize AllocationBytes;
+    VkDeviceSize PeakBytes;
+};
+
+struct MemoryHeapStats {
+    VkMemoryHeapFlags Flags;
+    VkDeviceSize Size;
+    VkDeviceSize Budget;
+    VkDeviceSize Usage;
+    VkDeviceSize BlockBytes;
+    VkDeviceSize AllocationBytes;
+    std::uint32_t BlockCount;
+    std::uint32_t AllocationCount;
+};
+
+namespace vkutils {
+    const char *GetMemoryCategoryName(MemoryCategory category);
+}  // namespace vkutils
+
+class MemoryTelemetry {
+   public:
+    MemoryTelemetry() = default;
+    ~MemoryTelemetry() = default;
+
+    void init(VmaAllocator allocator, bool memoryBudget);
+    void destroy();
+
+    void track(VmaAllocation allocation, MemoryCategory category);
+    void untrack(VmaAllocation allocation);
+
+    std::vector<MemoryHeapStats> getHeapStats() const;
+    MemoryCategoryStats getCategoryStats(MemoryCategory category) const;
+    bool hasMemoryBudget() const;
+
+    bool writeStats(const std::filesystem::path &filePath) const;
+
+   private:
+    VmaAllocator m_Allocator{nullptr};
+    bool m_MemoryBudget{false};
+
+    mutable std::mutex m_Mutex{};
+    std::array<MemoryCategoryStats, MEMORY_CATEGORY_COUNT> m_Categories{};
+};
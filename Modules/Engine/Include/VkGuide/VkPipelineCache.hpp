@@ -0,0 +1,34 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+
+#include <filesystem>
+
+class PipelineCache {
+   public:
+    PipelineCache() = default;
+    ~PipelineCache() = default;
+
+    void init(VkDevice device, VkPhysicalDevice physicalDevice, const std::filesystem::path &directory);
+    void save();
+    void destroy();
+
+    void recordCreationTime(double milliseconds);
+
+    VkPipelineCache get() const;
+    bool isWarm() const;
+
+   private:
+    bool load(std::vector<char> &outData);
+    bool isCompatible(const std::vector<char> &data) const;
+
+   private:
+    VkDevice m_Device{VK_NULL_HANDLE};
+    VkPipelineCache m_Cache{VK_NULL_HANDLE};
+
+    VkPhysicalDeviceProperties m_Properties{};
+    std::filesystem::path m_FilePath{};
+
+    bool m_IsWarm{false};
+    double m_ColdCreationTime{0.0};
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+#include <VkGuide/VkPipelines.hpp>
+
+#include <atomic>
+#include <future>
+#include <mutex>
+
+class JobSystem;
+class PipelineLibraryLinker;
+
+class PipelineHandle {
+   public:
+    PipelineHandle() = default;
+    explicit PipelineHandle(std::shared_future<VkPipeline> future);
+    ~PipelineHandle() = default;
+
+    bool isValid() const;
+    bool isReady() const;
+    VkPipeline get() const;
+
+   private:
+    std::shared_future<VkPipeline> m_Future{};
+};
+
+class PipelineCompiler {
+   public:
+    PipelineCompiler() = default;
+    ~PipelineCompiler() = default;
+
+    void init(VkDevice device, VkPipelineCache pipelineCache, JobSystem *jobSystem);
+
+    PipelineHandle compile(const PipelineBuilder &builder, VkPipelineLayout layout, VkPipeline *outPipeline = nullptr);
+    PipelineHandle compileCompute(const VkComputePipelineCreateInfo &info, VkPipeline *outPipeline = nullptr);
+    PipelineHandle link(const PipelineBuilder &builder, VkPipelineLayout layout, PipelineLibraryLinker *linker, VkPipeline *outPipeline = nullptr);
+    PipelineHandle optimize(const PipelineBuilder &builder, VkPipelineLayout layout, PipelineLibraryLinker *linker);
+
+    void destroyShaderModuleWhenIdle(VkShaderModule shaderModule);
+
+    void waitIdle();
+
+    std::uint32_t getSubmittedCount() const;
+    double getAverageCompileTime() const;
+
+   private:
+    PipelineHandle track(std::future<VkPipeline> &&future);
+
+   private:
+    VkDevice m_Device{VK_NULL_HANDLE};
+    VkPipelineCache m_PipelineCache{VK_NULL_HANDLE};
+    JobSystem *m_JobSystem{nullptr};
+    std::uint32_t m_JobGroup{0};
+
+    std::mutex m_Mutex{};
+    std::vector<std::shared_future<VkPipeline>> m_Pending{};
+    std::vector<VkShaderModule> m_PendingShaderModules{};
+    std::uint32_t m_SubmittedCount{0};
+
+    std::atomic<std::uint32_t> m_CompileCount{0};
+    std::atomic<std::uint64_t> m_CompileMicroseconds{0};
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+#include <VkGuide/VkPipelines.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+class PipelineLibraryLinker {
+   public:
+    PipelineLibraryLinker() = default;
+    ~PipelineLibraryLinker() = default;
+
+    void init(VkDevice device, VkPipelineCache pipelineCache, bool isSupported, bool hasFastLinking);
+    void destroy();
+
+    bool isSupported() const;
+    bool hasFastLinking() const;
+
+    VkPipeline link(const PipelineBuilder &builder, VkPipelineLayout layout, bool optimize);
+
+    std::uint32_t getLibraryCount() const;
+    double getAverageLinkTime() const;
+    double getAverageOptimizedLinkTime() const;
+
+   private:
+    VkPipeline getLibrary(const PipelineBuilder &builder, VkPipelineLayout layout, std::uint32_t part);
+
+   private:
+    VkDevice m_Device{VK_NULL_HANDLE};
+    VkPipelineCache m_PipelineCache{VK_NULL_HANDLE};
+    bool m_IsSupported{false};
+    bool m_HasFastLinking{false};
+
+    mutable std::mutex m_Mutex{};
+    std::array<std::unordered_map<PipelineStateKey, VkPipeline, PipelineStateKeyHash>, 4> m_Libraries{};
+
+    std::atomic<std::uint32_t> m_LinkCount{0};
+    std::atomic<std::uint64_t> m_LinkMicroseconds{0};
+    std::atomic<std::uint32_t> m_OptimizedLinkCount{0};
+    std::atomic<std::uint64_t> m_OptimizedLinkMicroseconds{0};
+};
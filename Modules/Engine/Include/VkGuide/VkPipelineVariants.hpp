@@ -0,0 +1,45 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+#include <VkGuide/VkPipelines.hpp>
+#include <VkGuide/VkPipelineCompiler.hpp>
+#include <VkGuide/VkPipelineLibrary.hpp>
+
+#include <mutex>
+#include <unordered_map>
+
+class PipelineVariantCache {
+   public:
+    PipelineVariantCache() = default;
+    ~PipelineVariantCache() = default;
+
+    void init(VkDevice device, PipelineCompiler *compiler, PipelineLibraryLinker *linker = nullptr);
+    void destroy();
+
+    PipelineHandle getPipeline(const PipelineBuilder &builder, VkPipelineLayout layout, VkPipeline *outPipeline = nullptr);
+    bool replace(VkPipeline oldPipeline, VkPipeline newPipeline);
+
+    std::vector<std::pair<VkPipeline, VkPipeline>> applyOptimizedPipelines();
+
+    std::uint32_t getVariantCount() const;
+    std::uint32_t getHitCount() const;
+    std::uint32_t getMissCount() const;
+
+   private:
+    struct Variant {
+        PipelineHandle Pipeline;
+        PipelineHandle OptimizedPipeline;
+    };
+
+   private:
+    VkDevice m_Device{VK_NULL_HANDLE};
+    PipelineCompiler *m_Compiler{nullptr};
+    PipelineLibraryLinker *m_Linker{nullptr};
+
+    mutable std::mutex m_Mutex{};
+    std::unordered_map<PipelineStateKey, Variant, PipelineStateKeyHash> m_Variants{};
+    std::vector<PipelineHandle> m_DiscardedPipelines{};
+    std::uint32_t m_PendingOptimizations{0};
+    std::uint32_t m_HitCount{0};
+    std::uint32_t m_MissCount{0};
+};
@@ -4,8 +4,58 @@
 
 namespace vkutils {
     bool LoadShaderModule(VkDevice device, const char *filePath, VkShaderModule *outShaderModule);
+    VkPrimitiveTopology GetTopologyClass(VkPrimitiveTopology topology);
 }  // namespace vkutils
 
+using DynamicStateFlags = std::uint32_t;
+
+constexpr DynamicStateFlags DYNAMIC_STATE_RASTERIZATION{1U << 0};
+constexpr DynamicStateFlags DYNAMIC_STATE_DEPTH{1U << 1};
+constexpr DynamicStateFlags DYNAMIC_STATE_BLEND{1U << 2};
+
+struct PipelineDynamicState {
+    VkCullModeFlags CullMode;
+    VkFrontFace FrontFace;
+    VkPrimitiveTopology Topology;
+    VkBool32 DepthTestEnable;
+    VkBool32 DepthWriteEnable;
+    VkCompareOp DepthCompareOp;
+    VkBool32 BlendEnable;
+    VkColorBlendEquationEXT BlendEquation;
+    VkColorComponentFlags ColorWriteMask;
+};
+
+struct PipelineStateKey {
+    VkShaderModule VertexShader;
+    VkShaderModule FragmentShader;
+    VkPipelineLayout Layout;
+    VkPrimitiveTopology Topology;
+    VkPolygonMode PolygonMode;
+    VkCullModeFlags CullMode;
+    VkFrontFace FrontFace;
+    VkBool32 BlendEnable;
+    VkBlendFactor SrcColorBlendFactor;
+    VkBlendFactor DstColorBlendFactor;
+    VkBlendOp ColorBlendOp;
+    VkBlendFactor SrcAlphaBlendFactor;
+    VkBlendFactor DstAlphaBlendFactor;
+    VkBlendOp AlphaBlendOp;
+    VkColorComponentFlags ColorWriteMask;
+    VkBool32 DepthTestEnable;
+    VkBool32 DepthWriteEnable;
+    VkCompareOp DepthCompareOp;
+    VkSampleCountFlagBits RasterizationSamples;
+    VkFormat ColorAttachmentFormat;
+    VkFormat DepthAttachmentFormat;
+    DynamicStateFlags DynamicState;
+
+    bool operator==(const PipelineStateKey &) const = default;
+};
+
+struct PipelineStateKeyHash {
+    std::size_t operator()(const PipelineStateKey &key) const;
+};
+
 class PipelineBuilder {
    public:
     PipelineBuilder();
@@ -23,10 +73,19 @@ class PipelineBuilder {
     void setMultisamplingNone();
     void setBlendingDisabled();
     void setDepthTestDisabled();
+    void setDynamicState(DynamicStateFlags flags);
 
     void clear();
 
-    VkPipeline build(VkDevice device, VkPipelineLayout layout);
+    PipelineStateKey getStateKey(VkPipelineLayout layout) const;
+    PipelineDynamicState getDynamicState() const;
+
+    VkPipeline build(VkDevice device, VkPipelineLayout layout, VkPipelineCache pipelineCache = VK_NULL_HANDLE) const;
+    VkPipeline buildLibrary(VkDevice device, VkPipelineLayout layout, VkPipelineCache pipelineCache, VkGraphicsPipelineLibraryFlagsEXT libraryFlags) const;
+
+   private:
+    VkPipeline create(VkDevice device, VkPipelineLayout layout, VkPipelineCache pipelineCache, VkPipelineCreateFlags flags, VkGraphicsPipelineLibraryFlagsEXT libraryFlags) const;
+
    private:
     std::vector<VkPipelineShaderStageCreateInfo> m_ShaderStages{};
     VkPipelineInputAssemblyStateCreateInfo m_InputAssembly{};
@@ -36,4 +95,5 @@ class PipelineBuilder {
     VkPipelineDepthStencilStateCreateInfo m_DepthStencil{};
     VkPipelineRenderingCreateInfo m_RenderInfo{};
     VkFormat m_ColorAttachmentFormat{VK_FORMAT_UNDEFINED};
+    DynamicStateFlags m_DynamicState{0};
 };
\ No newline at end of file
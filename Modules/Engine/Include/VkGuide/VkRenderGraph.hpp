@@ -0,0 +1,173 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+
+#include <memory_resource>
+
+class MemoryTelemetry;
+class RenderGraph;
+
+constexpr std::uint32_t RENDER_GRAPH_INVALID_RESOURCE{~0U};
+
+enum class RenderGraphUsage : std::uint32_t {
+    TransferRead,
+    TransferWrite,
+    ComputeStorageRead,
+    ComputeStorageWrite,
+    ComputeSampled,
+    FragmentSampled,
+    VertexStorageRead,
+    ColorAttachmentWrite,
+    ColorAttachmentReadWrite,
+    DepthAttachmentWrite,
+    DepthAttachmentRead,
+};
+
+struct RenderGraphImageDesc {
+    VkFormat Format;
+    VkExtent2D Extent;
+
+    bool operator==(const RenderGraphImageDesc &other) const {
+        return Format == other.Format && Extent.width == other.Extent.width && Extent.height == other.Extent.height;
+    }
+};
+
+struct RenderGraphStats {
+    std::uint32_t PassCount;
+    std::uint32_t CulledPassCount;
+    std::uint32_t BarrierCount;
+    std::uint32_t BarrierBatchCount;
+    std::uint32_t TransientImageCount;
+    std::uint32_t TransientBlockCount;
+    VkDeviceSize TransientBytes;
+    VkDeviceSize TransientAliasedBytes;
+};
+
+class RenderGraphPassBuilder {
+   public:
+    RenderGraphPassBuilder(RenderGraph *graph, std::uint32_t pass);
+
+    RenderGraphPassBuilder &access(std::uint32_t resource, RenderGraphUsage usage);
+
+   private:
+    RenderGraph *m_Graph;
+    std::uint32_t m_Pass;
+};
+
+class RenderGraph {
+   public:
+    RenderGraph() = default;
+    ~RenderGraph() = default;
+
+    void init(VkDevice device, VmaAllocator allocator, MemoryTelemetry *memoryTelemetry, std::uint32_t framesInFlight);
+    void destroy();
+
+    void reset(std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+
+    std::uint32_t importImage(const char *name, VkImage image, VkImageView view, VkImageAspectFlags aspect, VkImageLayout finalLayout = VK_IMAGE_LAYOUT_UNDEFINED, VkPipelineStageFlags2 waitStage = VK_PIPELINE_STAGE_2_NONE);
+    std::uint32_t importBuffer(const char *name, VkBuffer buffer);
+    std::uint32_t createImage(const char *name, const RenderGraphImageDesc &desc);
+
+    RenderGraphPassBuilder addPass(const char *name, std::function<void(VkCommandBuffer commandBuffer)> &&execute);
+
+    void execute(VkCommandBuffer commandBuffer, std::uint64_t frameNumber);
+
+    VkImage getImage(std::uint32_t resource) const;
+    VkImageView getImageView(std::uint32_t resource) const;
+    const RenderGraphStats &getStats() const;
+
+   private:
+    friend class RenderGraphPassBuilder;
+
+    struct ResourceAccess {
+        std::uint32_t Resource;
+        RenderGraphUsage Usage;
+    };
+
+    struct Pass {
+        std::string Name;
+        std::function<void(VkCommandBuffer commandBuffer)> Execute;
+        std::pmr::vector<ResourceAccess> Accesses;
+        bool IsCulled;
+    };
+
+    struct ResourceState {
+        VkImageLayout Layout;
+        VkPipelineStageFlags2 WriteStage;
+        VkAccessFlags2 WriteAccess;
+        VkPipelineStageFlags2 ReadStages;
+        VkPipelineStageFlags2 VisibleStages;
+        VkAccessFlags2 VisibleAccess;
+    };
+
+    struct Resource {
+        std::string Name;
+        bool IsImage;
+        bool IsTransient;
+        VkImage Image;
+        VkImageView View;
+        VkBuffer Buffer;
+        VkImageAspectFlags Aspect;
+        VkImageLayout FinalLayout;
+        VkPipelineStageFlags2 WaitStage;
+        RenderGraphImageDesc Desc;
+        VkImageUsageFlags Usage;
+        std::uint32_t FirstPass;
+        std::uint32_t LastPass;
+        std::uint32_t Transient;
+        ResourceState State;
+    };
+
+    struct TransientImage {
+        RenderGraphImageDesc Desc;
+        VkImageUsageFlags Usage;
+        std::uint32_t FirstPass;
+        std::uint32_t LastPass;
+        std::uint32_t Block;
+        std::uint32_t Previous;
+        VkImage Image;
+        VkImageView View;
+    };
+
+    struct TransientBlock {
+        VmaAllocation Allocation;
+        VkMemoryRequirements Requirements;
+        std::uint32_t LastImage;
+    };
+
+    struct RetiredTransients {
+        std::vector<TransientImage> Images;
+        std::vector<TransientBlock> Blocks;
+        std::uint64_t FrameNumber;
+    };
+
+   private:
+    static bool applyAccess(ResourceState &state, RenderGraphUsage usage, bool isImage, VkPipelineStageFlags2 &srcStage, VkAccessFlags2 &srcAccess);
+
+    void cull();
+    void allocateTransients(std::uint64_t frameNumber);
+    void computeInitialStates();
+    void flushBarriers(VkCommandBuffer commandBuffer);
+
+    void destroyTransients(const std::vector<TransientImage> &images, const std::vector<TransientBlock> &blocks);
+    void releaseRetired(std::uint64_t frameNumber);
+
+   private:
+    VkDevice m_Device{VK_NULL_HANDLE};
+    VmaAllocator m_Allocator{nullptr};
+    MemoryTelemetry *m_MemoryTelemetry{nullptr};
+    std::uint32_t m_FramesInFlight{0};
+    std::pmr::memory_resource *m_Memory{std::pmr::get_default_resource()};
+
+    std::vector<Pass> m_Passes{};
+    std::vector<Resource> m_Resources{};
+
+    std::vector<TransientImage> m_TransientImages{};
+    std::vector<TransientBlock> m_TransientBlocks{};
+    std::deque<RetiredTransients> m_RetiredTransients{};
+
+    std::vector<VkImageMemoryBarrier2> m_ImageBarriers{};
+    std::vector<VkBufferMemoryBarrier2> m_BufferBarriers{};
+
+    RenderGraphStats m_Stats{};
+};
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+#include <VkGuide/VkPipelines.hpp>
+#include <VkGuide/VkTypes.hpp>
+
+#include <memory_resource>
+#include <unordered_map>
+
+class DynamicStateTracker;
+class JobSystem;
+
+enum class RenderPassType : std::uint8_t {
+    Opaque = 0,
+    Transparent = 1,
+};
+
+namespace drawkey {
+    constexpr std::uint32_t PASS_BITS{4};
+    constexpr std::uint32_t PIPELINE_BITS{12};
+    constexpr std::uint32_t MATERIAL_BITS{16};
+    constexpr std::uint32_t MESH_BITS{16};
+    constexpr std::uint32_t DEPTH_BITS{16};
+
+    constexpr std::uint32_t DEPTH_SHIFT{0};
+    constexpr std::uint32_t MESH_SHIFT{DEPTH_SHIFT + DEPTH_BITS};
+    constexpr std::uint32_t MATERIAL_SHIFT{MESH_SHIFT + MESH_BITS};
+    constexpr std::uint32_t PIPELINE_SHIFT{MATERIAL_SHIFT + MATERIAL_BITS};
+    constexpr std::uint32_t PASS_SHIFT{PIPELINE_SHIFT + PIPELINE_BITS};
+
+    static_assert(PASS_SHIFT + PASS_BITS == 64);
+
+    std::uint64_t Make(RenderPassType pass, std::uint32_t pipeline, std::uint32_t material, std::uint32_t mesh, float depth);
+    std::uint64_t StripDepth(std::uint64_t key);
+}  // namespace drawkey
+
+struct RenderObject {
+    std::uint32_t IndexCount;
+    std::uint32_t FirstIndex;
+    VkBuffer IndexBuffer;
+    VkDeviceAddress VertexBufferAddress;
+
+    VkPipeline Pipeline;
+    VkPipelineLayout Layout;
+    const PipelineDynamicState *DynamicState;
+
+    glm::mat4 Transform;
+    std::uint32_t TextureIndex;
+    std::uint32_t SamplerIndex;
+};
+
+struct InstanceBufferView {
+    GPUInstanceData *Data;
+    VkDeviceAddress Address;
+    std::uint32_t First;
+    std::uint32_t Capacity;
+};
+
+struct DrawStats {
+    std::uint32_t ObjectCount;
+    std::uint32_t DrawCalls;
+    std::uint32_t InstanceCount;
+    std::uint32_t DroppedObjects;
+    std::uint32_t PipelineBinds;
+    std::uint32_t IndexBufferBinds;
+    std::uint32_t PushConstantUpdates;
+    std::uint32_t DynamicStateChanges;
+    std::uint32_t SkippedPipelineBinds;
+    std::uint32_t SkippedIndexBufferBinds;
+};
+
+class RenderList {
+   public:
+    RenderList() = default;
+    ~RenderList() = default;
+
+    void clear();
+
+    std::uint32_t getPipelineId(VkPipeline pipeline);
+    void replacePipeline(VkPipeline retired, VkPipeline pipeline);
+    std::uint32_t getMeshId(VkBuffer indexBuffer, std::uint32_t firstIndex);
+
+    void add(const RenderObject &object, std::uint64_t sortKey);
+    void sort(JobSystem *jobSystem = nullptr, std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+
+    DrawStats submit(VkCommandBuffer commandBuffer, DynamicStateTracker *dynamicStateTracker, const InstanceBufferView &instances) const;
+
+    std::uint32_t getObjectCount() const;
+    std::span<const std::uint64_t> getSortedKeys() const;
+    std::span<const std::uint32_t> getSortedOrder() const;
+    const RenderObject &getObject(std::uint32_t index) const;
+
+   private:
+    void radixSort(JobSystem *jobSystem, std::pmr::memory_resource *memory);
+
+   private:
+    std::vector<RenderObject> m_Objects{};
+    std::vector<std::uint64_t> m_Keys{};
+    std::vector<std::uint32_t> m_Order{};
+
+    struct MeshKey {
+        VkBuffer IndexBuffer;
+        std::uint32_t FirstIndex;
+
+        bool operator==(const MeshKey &other) const = default;
+    };
+
+    struct MeshKeyHash {
+        std::size_t operator()(const MeshKey &key) const;
+    };
+
+    std::unordered_map<VkPipeline, std::uint32_t> m_PipelineIds{};
+    std::vector<std::uint32_t> m_FreePipelineIds{};
+    std::uint32_t m_NextPipelineId{1};
+    std::unordered_map<MeshKey, std::uint32_t, MeshKeyHash> m_MeshIds{};
+};
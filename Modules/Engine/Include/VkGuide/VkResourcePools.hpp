@@ -0,0 +1,163 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+#include <VkGuide/VkTypes.hpp>
+
+class DeferredDeletionQueue;
+class MemoryTelemetry;
+
+constexpr std::uint32_t RESOURCE_INVALID_INDEX{~0U};
+
+template <typename T>
+struct ResourceHandle {
+    std::uint32_t Index{RESOURCE_INVALID_INDEX};
+    std::uint32_t Generation{0};
+
+    bool isValid() const {
+        return Index != RESOURCE_INVALID_INDEX;
+    }
+
+    bool operator==(const ResourceHandle &other) const {
+        return Index == other.Index && Generation == other.Generation;
+    }
+};
+
+using ImageHandle = ResourceHandle<AllocatedImage>;
+using MeshHandle = ResourceHandle<GPUMeshBuffers>;
+
+template <typename T>
+class SlotMap {
+   public:
+    SlotMap() = default;
+    ~SlotMap() = default;
+
+    ResourceHandle<T> insert(T &&value) {
+        std::uint32_t index = 0;
+        if (m_FreeSlots.empty()) {
+            index = (std::uint32_t)m_Slots.size();
+            m_Slots.emplace_back(Slot{.DenseIndex = 0, .Generation = 1});
+        } else {
+            index = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        }
+
+        Slot &slot = m_Slots[index];
+        slot.DenseIndex = (std::uint32_t)m_Values.size();
+        m_Values.emplace_back(std::move(value));
+        m_DenseSlots.emplace_back(index);
+
+        return ResourceHandle<T>{.Index = index, .Generation = slot.Generation};
+    }
+
+    std::optional<T> remove(ResourceHandle<T> handle) {
+        if (!contains(handle)) return std::nullopt;
+
+        Slot &slot = m_Slots[handle.Index];
+        const std::uint32_t denseIndex = slot.DenseIndex;
+        const std::uint32_t lastIndex = (std::uint32_t)m_Values.size() - 1;
+
+        T value = std::move(m_Values[denseIndex]);
+        if (denseIndex != lastIndex) {
+            m_Values[denseIndex] = std::move(m_Values[lastIndex]);
+            m_DenseSlots[denseIndex] = m_DenseSlots[lastIndex];
+            m_Slots[m_DenseSlots[denseIndex]].DenseIndex = denseIndex;
+        }
+        m_Values.pop_back();
+        m_DenseSlots.pop_back();
+
+        slot.Generation = slot.Generation == ~0U ? 1 : slot.Generation + 1;
+        m_FreeSlots.emplace_back(handle.Index);
+
+        return value;
+    }
+
+    bool contains(ResourceHandle<T> handle) const {
+        return handle.Index < m_Slots.size() && m_Slots[handle.Index].Generation == handle.Generation;
+    }
+
+    T *get(ResourceHandle<T> handle) {
+        return contains(handle) ? &m_Values[m_Slots[handle.Index].DenseIndex] : nullptr;
+    }
+
+    const T *get(ResourceHandle<T> handle) const {
+        return contains(handle) ? &m_Values[m_Slots[handle.Index].DenseIndex] : nullptr;
+    }
+
+    std::span<T> values() {
+        return m_Values;
+    }
+
+    std::span<const T> values() const {
+        return m_Values;
+    }
+
+    std::uint32_t size() const {
+        return (std::uint32_t)m_Values.size();
+    }
+
+    void clear() {
+        for (std::uint32_t index : m_DenseSlots) {
+            Slot &slot = m_Slots[index];
+            slot.Generation = slot.Generation == ~0U ? 1 : slot.Generation + 1;
+            m_FreeSlots.emplace_back(index);
+        }
+        m_Values.clear();
+        m_DenseSlots.clear();
+    }
+
+   private:
+    struct Slot {
+        std::uint32_t DenseIndex;
+        std::uint32_t Generation;
+    };
+
+   private:
+    std::vector<T> m_Values{};
+    std::vector<std::uint32_t> m_DenseSlots{};
+    std::vector<Slot> m_Slots{};
+    std::vector<std::uint32_t> m_FreeSlots{};
+};
+
+struct ResourcePoolStats {
+    std::uint32_t ImageCount;
+    std::uint32_t MeshCount;
+    std::uint32_t StaleLookupCount;
+};
+
+class ResourcePools {
+   public:
+    ResourcePools() = default;
+    ~ResourcePools() = default;
+
+    void init(VkDevice device, VmaAllocator allocator, MemoryTelemetry *memoryTelemetry, DeferredDeletionQueue *deletionQueue);
+    void destroy();
+
+    ImageHandle addImage(const AllocatedImage &image);
+    MeshHandle addMesh(const GPUMeshBuffers &mesh);
+
+    const AllocatedImage *getImage(ImageHandle handle);
+    const GPUMeshBuffers *getMesh(MeshHandle handle);
+
+    void releaseImage(ImageHandle handle, std::uint64_t frameNumber);
+    void releaseMesh(MeshHandle handle, std::uint64_t frameNumber);
+
+    ResourcePoolStats getStats() const;
+
+   private:
+    template <typename T>
+    const T *lookup(const SlotMap<T> &pool, ResourceHandle<T> handle);
+
+    void destroyBuffer(const AllocatedBuffer &buffer);
+    void destroyImage(const AllocatedImage &image);
+
+   private:
+    VkDevice m_Device{VK_NULL_HANDLE};
+    VmaAllocator m_Allocator{nullptr};
+    MemoryTelemetry *m_MemoryTelemetry{nullptr};
+    DeferredDeletionQueue *m_DeletionQueue{nullptr};
+
+    SlotMap<AllocatedImage> m_Images{};
+    SlotMap<GPUMeshBuffers> m_Meshes{};
+
+    std::uint32_t m_StaleLookupCount{0};
+};
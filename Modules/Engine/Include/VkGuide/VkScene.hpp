@@ -0,0 +1,79 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+
+#include <glm/vec3.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+class JobSystem;
+
+constexpr std::uint32_t SCENE_NO_PARENT{~0U};
+constexpr std::int32_t SCENE_NO_MESH{-1};
+
+class SceneGraph {
+   public:
+    struct NodeDescription {
+        std::string Name{};
+        std::uint32_t Parent{SCENE_NO_PARENT};
+        std::int32_t MeshIndex{SCENE_NO_MESH};
+        glm::vec3 Translation{0.0f};
+        glm::quat Rotation{1.0f, 0.0f, 0.0f, 0.0f};
+        glm::vec3 Scale{1.0f};
+    };
+
+   public:
+    SceneGraph() = default;
+    ~SceneGraph() = default;
+
+    void clear();
+
+    std::uint32_t addNode(const NodeDescription &description);
+    void finalize();
+
+    void setTranslation(std::uint32_t node, const glm::vec3 &translation);
+    void setRotation(std::uint32_t node, const glm::quat &rotation);
+    void setScale(std::uint32_t node, const glm::vec3 &scale);
+
+    void updateTransforms(JobSystem *jobSystem = nullptr);
+
+    std::uint32_t findNode(const std::string &name) const;
+
+    std::uint32_t getNodeCount() const;
+    std::uint32_t getLevelCount() const;
+    std::uint32_t getLastUpdatedCount() const;
+
+    const std::string &getName(std::uint32_t node) const;
+    std::uint32_t getParent(std::uint32_t node) const;
+    std::int32_t getMeshIndex(std::uint32_t node) const;
+    const glm::vec3 &getTranslation(std::uint32_t node) const;
+    const glm::quat &getRotation(std::uint32_t node) const;
+    const glm::vec3 &getScale(std::uint32_t node) const;
+    const glm::mat4 &getLocalMatrix(std::uint32_t node) const;
+    const glm::mat4 &getWorldMatrix(std::uint32_t node) const;
+
+    std::span<const glm::mat4> getWorldMatrices() const;
+    std::span<const std::int32_t> getMeshIndices() const;
+
+   private:
+    void markDirty(std::uint32_t node);
+    std::uint32_t updateRange(std::uint32_t begin, std::uint32_t end);
+
+   private:
+    std::vector<std::string> m_Names{};
+    std::vector<std::uint32_t> m_Parents{};
+    std::vector<std::uint32_t> m_Depths{};
+    std::vector<std::int32_t> m_MeshIndices{};
+
+    std::vector<glm::vec3> m_Translations{};
+    std::vector<glm::quat> m_Rotations{};
+    std::vector<glm::vec3> m_Scales{};
+
+    std::vector<glm::mat4> m_LocalMatrices{};
+    std::vector<glm::mat4> m_WorldMatrices{};
+    std::vector<std::uint8_t> m_Dirty{};
+
+    std::vector<std::uint32_t> m_LevelOffsets{};
+
+    bool m_AnyDirty{false};
+    std::uint32_t m_LastUpdatedCount{0};
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+
+#include <filesystem>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+constexpr std::uint32_t SHADER_ARCHIVE_MAGIC{0x41534B56};  // "VKSA"
+constexpr std::uint32_t SHADER_ARCHIVE_VERSION{1};
+constexpr std::uint32_t SHADER_ARCHIVE_NAME_SIZE{64};
+constexpr std::uint32_t SHADER_ARCHIVE_ALIGNMENT{4};
+
+struct ShaderArchiveHeader {
+    std::uint32_t Magic;
+    std::uint32_t Version;
+    std::uint32_t EntryCount;
+    std::uint32_t Reserved;
+};
+
+struct ShaderArchiveEntry {
+    char Name[SHADER_ARCHIVE_NAME_SIZE];
+    std::uint64_t ContentHash;
+    std::uint32_t Offset;
+    std::uint32_t Size;
+};
+
+struct CachedShaderModule {
+    VkShaderModule Module;
+    std::vector<std::uint32_t> Code;
+};
+
+struct ShaderBlob {
+    std::span<const std::uint32_t> Code;
+    std::uint64_t Hash;
+};
+
+namespace vkutils {
+    std::uint64_t HashBytes(const void *data, std::size_t size, std::uint64_t seed = 0xCBF29CE484222325ULL);
+}  // namespace vkutils
+
+class ShaderArchive {
+   public:
+    ShaderArchive() = default;
+    ~ShaderArchive() = default;
+
+    ShaderArchive(const ShaderArchive &) = delete;
+    ShaderArchive &operator=(const ShaderArchive &) = delete;
+
+    bool open(const std::filesystem::path &filePath);
+    void close();
+
+    bool isOpen() const;
+    std::optional<ShaderBlob> find(std::string_view name) const;
+    std::filesystem::file_time_type getWriteTime() const;
+
+    static bool Write(const std::filesystem::path &filePath, std::span<const std::filesystem::path> shaderPaths);
+
+   private:
+    bool validate() const;
+
+   private:
+    const std::uint8_t *m_Data{nullptr};
+    std::size_t m_Size{0};
+    std::filesystem::file_time_type m_WriteTime{};
+
+#if defined(_WIN32)
+    void *m_File{nullptr};
+    void *m_Mapping{nullptr};
+#else
+    int m_File{-1};
+#endif
+};
+
+class ShaderModuleCache {
+   public:
+    ShaderModuleCache() = default;
+    ~ShaderModuleCache() = default;
+
+    void init(VkDevice device, const ShaderArchive *archive);
+    void destroy();
+
+    bool getShaderModule(const char *filePath, VkShaderModule *outShaderModule);
+
+    std::uint32_t getModuleCount() const;
+    std::uint32_t getHitCount() const;
+    std::uint32_t getLooseOverrideCount() const;
+
+   private:
+    bool createShaderModule(std::span<const std::uint32_t> code, std::uint64_t hash, VkShaderModule *outShaderModule);
+
+   private:
+    VkDevice m_Device{VK_NULL_HANDLE};
+    const ShaderArchive *m_Archive{nullptr};
+
+    std::mutex m_Mutex{};
+    std::unordered_multimap<std::uint64_t, CachedShaderModule> m_Modules{};
+    std::uint32_t m_HitCount{0};
+    std::uint32_t m_LooseOverrideCount{0};
+};
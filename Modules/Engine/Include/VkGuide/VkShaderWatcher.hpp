@@ -0,0 +1,28 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+
+#include <filesystem>
+#include <unordered_map>
+
+class ShaderWatcher {
+   public:
+    ShaderWatcher() = default;
+    ~ShaderWatcher() = default;
+
+    void init();
+    void shutdown();
+
+    bool addDirectory(const std::filesystem::path &directory);
+
+    std::vector<std::filesystem::path> pollChanges();
+
+   private:
+#if defined(__linux__)
+    int m_InotifyFd{-1};
+    std::unordered_map<int, std::filesystem::path> m_Directories{};
+#else
+    std::vector<std::filesystem::path> m_Directories{};
+    std::unordered_map<std::string, std::filesystem::file_time_type> m_Timestamps{};
+#endif
+};
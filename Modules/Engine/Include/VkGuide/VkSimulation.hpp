@@ -0,0 +1,144 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+#include <VkGuide/VkCamera.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <glm/vec3.hpp>
+
+class JobSystem;
+class SceneGraph;
+
+constexpr double SIMULATION_TICK_RATE{60.0};
+constexpr std::uint32_t SIMULATION_MAX_CATCH_UP_TICKS{8};
+
+template <typename T>
+class TripleBuffer {
+   public:
+    TripleBuffer() = default;
+    ~TripleBuffer() = default;
+
+    TripleBuffer(const TripleBuffer &) = delete;
+    TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+    T &getWriteBuffer() {
+        return m_Buffers[m_Back];
+    }
+
+    void publish() {
+        m_Back = m_Middle.exchange(m_Back | DIRTY_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    bool acquire() {
+        if ((m_Middle.load(std::memory_order_relaxed) & DIRTY_BIT) == 0) return false;
+
+        m_Front = m_Middle.exchange(m_Front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    const T &getReadBuffer() const {
+        return m_Buffers[m_Front];
+    }
+
+   private:
+    static constexpr std::uint32_t INDEX_MASK{0x3};
+    static constexpr std::uint32_t DIRTY_BIT{0x4};
+
+   private:
+    std::array<T, 3> m_Buffers{};
+
+    alignas(64) std::atomic<std::uint32_t> m_Middle{1};
+    alignas(64) std::uint32_t m_Back{0};
+    alignas(64) std::uint32_t m_Front{2};
+};
+
+struct CameraState {
+    glm::vec3 Position;
+    glm::vec3 Front;
+    glm::vec3 Up;
+};
+
+struct SimulationStats {
+    std::uint64_t TickCount;
+    std::uint64_t SkippedTickCount;
+    float TickTime;
+    float AverageTickTime;
+};
+
+struct SimulationSnapshot {
+    std::uint64_t Tick;
+    double Time;
+
+    CameraState PreviousCamera;
+    CameraState Camera;
+
+    std::vector<glm::mat4> PreviousWorldMatrices;
+    std::vector<glm::mat4> WorldMatrices;
+
+    SimulationStats Stats;
+};
+
+namespace simulation {
+    glm::mat4 InterpolateView(const SimulationSnapshot &snapshot, float alpha);
+    glm::mat4 InterpolateWorldMatrix(const SimulationSnapshot &snapshot, std::uint32_t node, float alpha);
+}  // namespace simulation
+
+class Simulation {
+   public:
+    Simulation() = default;
+    ~Simulation() = default;
+
+    Simulation(const Simulation &) = delete;
+    Simulation &operator=(const Simulation &) = delete;
+
+    void init(SceneGraph *sceneGraph, JobSystem *jobSystem, double tickRate = SIMULATION_TICK_RATE);
+    void shutdown();
+
+    void start();
+
+    void setMovement(std::uint32_t movement);
+    void addMouseMotion(float xOffset, float yOffset);
+
+    const SimulationSnapshot &acquireSnapshot();
+    const SimulationSnapshot &getSnapshot() const;
+    float getInterpolationFactor(const SimulationSnapshot &snapshot) const;
+
+    double getTickRate() const;
+
+   private:
+    using Clock = std::chrono::steady_clock;
+
+   private:
+    void simulationLoop();
+    void tick();
+    void publishSnapshot(Clock::time_point tickTime);
+
+    double getTime(Clock::time_point timePoint) const;
+
+   private:
+    SceneGraph *m_SceneGraph{nullptr};
+    JobSystem *m_JobSystem{nullptr};
+
+    CameraManager m_Camera{};
+    CameraState m_PreviousCamera{};
+    std::vector<glm::mat4> m_PreviousWorldMatrices{};
+
+    TripleBuffer<SimulationSnapshot> m_Snapshots{};
+
+    std::thread m_Thread{};
+    std::atomic<bool> m_Running{false};
+
+    std::atomic<std::uint32_t> m_Movement{0};
+    std::atomic<float> m_MouseX{0.0f};
+    std::atomic<float> m_MouseY{0.0f};
+
+    Clock::time_point m_StartTime{};
+    Clock::duration m_TickDuration{};
+    double m_TickRate{SIMULATION_TICK_RATE};
+    std::uint64_t m_Tick{0};
+
+    SimulationStats m_Stats{};
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+#include <VkGuide/VkTypes.hpp>
+
+struct CompressedFormatSupport {
+    bool BC1;
+    bool BC3;
+    bool BC5;
+    bool BC7;
+};
+
+namespace vkutils {
+    bool IsBlockCompressed(VkFormat format);
+    bool IsSrgbFormat(VkFormat format);
+    std::uint32_t GetBlockByteSize(VkFormat format);
+    VkDeviceSize GetLevelByteSize(VkFormat format, VkExtent2D extent);
+
+    CompressedFormatSupport GetCompressedFormatSupport(VkPhysicalDevice physicalDevice, bool textureCompressionBC);
+    bool IsFormatSupported(const CompressedFormatSupport &support, VkFormat format);
+    VkFormat SelectCompressedFormat(const CompressedFormatSupport &support, const DecodedTexture &texture, bool isNormalMap);
+
+    DecodedTexture GenerateMipChain(const DecodedTexture &texture);
+    std::optional<DecodedTexture> CompressTexture(const DecodedTexture &texture, VkFormat format);
+}  // namespace vkutils
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+#include <VkGuide/VkResourcePools.hpp>
+#include <VkGuide/VkTypes.hpp>
+
+#include <memory_resource>
+
+class BindlessHeap;
+class DeferredDeletionQueue;
+class MemoryTelemetry;
+
+constexpr std::uint32_t STREAMING_RESIDENT_EXTENT{128};
+constexpr VkDeviceSize STREAMING_MAX_UPLOAD_BYTES{16 * 1024 * 1024};
+constexpr float STREAMING_BUDGET_USAGE{0.9f};
+
+constexpr std::uint32_t STREAMING_INVALID_TEXTURE{~0U};
+
+struct StreamingStats {
+    std::uint32_t TextureCount;
+    std::uint32_t FullyResidentCount;
+    std::uint32_t PendingCount;
+    std::uint32_t UploadCount;
+    std::uint32_t EvictionCount;
+    VkDeviceSize ResidentBytes;
+    VkDeviceSize BudgetBytes;
+    VkDeviceSize UploadedBytes;
+    VkDeviceSize EvictedBytes;
+};
+
+class TextureStreamer {
+   public:
+    TextureStreamer() = default;
+    ~TextureStreamer() = default;
+
+    void init(VkDevice device, VmaAllocator allocator, BindlessHeap *bindlessHeap, MemoryTelemetry *memoryTelemetry, ResourcePools *resourcePools, DeferredDeletionQueue *deletionQueue);
+    void destroy();
+
+    std::uint32_t addTexture(DecodedTexture &&texture);
+    void removeTexture(std::uint32_t texture);
+
+    void requestTexelDensity(std::uint32_t texture, float uvDensity, float pixelsPerUnit);
+    void update(VkCommandBuffer commandBuffer, std::uint64_t frameNumber, std::pmr::memory_resource *memory);
+
+    std::uint32_t getBindlessIndex(std::uint32_t texture) const;
+    std::uint32_t getResidentLevel(std::uint32_t texture) const;
+    const StreamingStats &getStats() const;
+
+   private:
+    struct StreamedTexture {
+        DecodedTexture Data;
+        ImageHandle Image;
+        std::uint32_t BindlessIndex;
+        std::uint32_t ResidentLevel;
+        std::uint32_t TailLevel;
+        std::uint32_t RequestedLevel;
+        std::uint64_t LastRequestedFrame;
+    };
+
+    struct ResidentUpload {
+        std::uint32_t Texture;
+        std::uint32_t Level;
+        AllocatedImage Image;
+        VkDeviceSize StagingOffset;
+    };
+
+   private:
+    VkDeviceSize getResidentSize(const StreamedTexture &texture, std::uint32_t level) const;
+    VkDeviceSize queryBudget() const;
+
+    AllocatedImage createResidentImage(const StreamedTexture &texture, std::uint32_t level);
+    void copyResidentLevels(VkCommandBuffer commandBuffer, const StreamedTexture &texture, const ResidentUpload &upload, VkBuffer stagingBuffer) const;
+    void makeResident(StreamedTexture &texture, std::uint32_t level, const AllocatedImage &image);
+    void releaseImage(StreamedTexture &texture);
+
+   private:
+    VkDevice m_Device{VK_NULL_HANDLE};
+    VmaAllocator m_Allocator{nullptr};
+    BindlessHeap *m_BindlessHeap{nullptr};
+    MemoryTelemetry *m_MemoryTelemetry{nullptr};
+    ResourcePools *m_ResourcePools{nullptr};
+    DeferredDeletionQueue *m_DeletionQueue{nullptr};
+
+    std::uint64_t m_FrameNumber{0};
+
+    std::vector<StreamedTexture> m_Textures{};
+    std::vector<std::uint32_t> m_FreeTextures{};
+
+    VkDeviceSize m_ResidentBytes{0};
+    StreamingStats m_Stats{};
+};
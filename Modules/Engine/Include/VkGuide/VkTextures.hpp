@@ -0,0 +1,83 @@
+#pragma once
+
+#include <VkGuide/Defines.hpp>
+#include <VkGuide/VkTypes.hpp>
+#include <VkGuide/VkTextureCompression.hpp>
+
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+
+class BindlessHeap;
+
+constexpr std::size_t TEXTURE_STAGING_BUDGET{64 * 1024 * 1024};
+constexpr std::size_t TEXTURE_STAGING_ALIGNMENT{16};
+constexpr std::uint64_t TEXTURE_CACHE_VERSION{1};
+constexpr const char *TEXTURE_CACHE_DIRECTORY{"Assets/TextureCache"};
+
+struct TextureSource {
+    std::string Name;
+    std::filesystem::path FilePath;
+    std::span<const std::uint8_t> Bytes;
+    VkFormat Format{VK_FORMAT_R8G8B8A8_UNORM};
+    bool IsNormalMap{false};
+};
+
+struct TextureStats {
+    std::uint32_t TextureCount;
+    std::uint32_t FailedCount;
+    std::uint32_t CompressedCount;
+    std::uint32_t CachedCount;
+    std::uint64_t EncodedBytes;
+    std::uint64_t UploadedBytes;
+    double DecodeTime;
+    double UploadTime;
+};
+
+struct SamplerKey {
+    VkFilter MagFilter{VK_FILTER_LINEAR};
+    VkFilter MinFilter{VK_FILTER_LINEAR};
+    VkSamplerMipmapMode MipmapMode{VK_SAMPLER_MIPMAP_MODE_LINEAR};
+    VkSamplerAddressMode AddressModeU{VK_SAMPLER_ADDRESS_MODE_REPEAT};
+    VkSamplerAddressMode AddressModeV{VK_SAMPLER_ADDRESS_MODE_REPEAT};
+    VkSamplerAddressMode AddressModeW{VK_SAMPLER_ADDRESS_MODE_REPEAT};
+
+    bool operator==(const SamplerKey &other) const = default;
+};
+
+struct SamplerKeyHash {
+    std::size_t operator()(const SamplerKey &key) const;
+};
+
+namespace vkutils {
+    std::optional<DecodedTexture> LoadTexture(const TextureSource &source, const CompressedFormatSupport &support);
+}  // namespace vkutils
+
+class SamplerCache {
+   public:
+    SamplerCache() = default;
+    ~SamplerCache() = default;
+
+    void init(VkDevice device, BindlessHeap *bindlessHeap);
+    void destroy();
+
+    VkSampler getSampler(const SamplerKey &key);
+    std::uint32_t getBindlessIndex(const SamplerKey &key);
+
+    std::uint32_t getSamplerCount() const;
+
+   private:
+    struct CachedSampler {
+        VkSampler Sampler;
+        std::uint32_t BindlessIndex;
+    };
+
+    const CachedSampler &getCachedSampler(const SamplerKey &key);
+
+   private:
+    VkDevice m_Device{VK_NULL_HANDLE};
+    BindlessHeap *m_BindlessHeap{nullptr};
+
+    mutable std::mutex m_Mutex{};
+    std::unordered_map<SamplerKey, CachedSampler, SamplerKeyHash> m_Samplers{};
+};
@@ -2,12 +2,35 @@
 
 #include <VkGuide/Defines.hpp>
 
+struct DeviceCapabilities {
+    bool GraphicsPipelineLibrary;
+    bool GraphicsPipelineLibraryFastLinking;
+    bool ExtendedDynamicState3Blend;
+    bool TextureCompressionBC;
+    bool MemoryBudget;
+};
+
 struct AllocatedImage {
     VkImage Image;
     VkImageView View;
     VmaAllocation Allocation;
     VkExtent3D Extent;
     VkFormat Format;
+    std::uint32_t MipLevels;
+};
+
+struct TextureLevel {
+    VkDeviceSize Offset;
+    VkDeviceSize Size;
+    VkExtent2D Extent;
+};
+
+struct DecodedTexture {
+    std::vector<std::uint8_t> Pixels;
+    VkExtent2D Extent;
+    VkFormat Format;
+    std::vector<TextureLevel> Levels;
+    bool IsCached;
 };
 
 struct AllocatedBuffer {
@@ -30,7 +53,19 @@ struct GPUMeshBuffers {
     VkDeviceAddress VertexBufferAddress;
 };
 
-struct GPUDrawPushConstants {
+struct alignas(16) GPUInstanceData {
     glm::mat4 WorldMatrix;
+    std::uint32_t TextureIndex;
+    std::uint32_t SamplerIndex;
+};
+
+struct GPUSceneData {
+    glm::mat4 View;
+    glm::mat4 Projection;
+    glm::mat4 ViewProjection;
+};
+
+struct GPUDrawPushConstants {
     VkDeviceAddress VertexBuffer;
+    VkDeviceAddress InstanceBuffer;
 };
\ No newline at end of file
@@ -2,8 +2,12 @@
 
 #include <VkGuide/Defines.hpp>
 
-namespace vkutils {
-    void TransitionImageLayout(VkCommandBuffer commandBuffer, VkImage image, VkImageLayout currentLayout, VkImageLayout newLayout);
+class BarrierBuilder;
 
+namespace vkutils {
     void CopyImageToImage(VkCommandBuffer commandBuffer, VkImage src, VkImage dst, VkExtent2D srcSize, VkExtent2D dstSize);
+
+    std::uint32_t GetMipLevelCount(VkExtent2D imageSize);
+
+    void GenerateMipmaps(VkCommandBuffer commandBuffer, BarrierBuilder &barriers, VkImage image, VkExtent2D imageSize, std::uint32_t mipLevels);
 }  // namespace vkutils
\ No newline at end of file
@@ -12,12 +12,16 @@
 #include <glm/gtx/transform.hpp>
 
 #include <VkGuide/Engine.hpp>
+#include <VkGuide/VkBarriers.hpp>
 #include <VkGuide/VkInits.hpp>
 #include <VkGuide/VkPipelines.hpp>
 #include <VkGuide/VkUtils.hpp>
 #include <VkGuide/VkCamera.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstdlib>
 #include <thread>
 
 #if defined(VKGUIDE_BUILD_TYPE_RELEASE)
@@ -26,8 +30,24 @@ constexpr bool g_UseValidationLayers{true};
 constexpr bool g_UseValidationLayers{true};
 #endif
 
+constexpr bool g_UseExtendedDynamicState{true};
+constexpr bool g_UseTextureCompression{true};
+
 VulkanEngine VulkanEngine::g_VkEngine{};
 
+static std::uint32_t getCameraMovement() {
+    const Uint8 *keys = SDL_GetKeyboardState(nullptr);
+
+    std::uint32_t movement = 0;
+    if (keys[SDL_SCANCODE_W]) movement |= (std::uint32_t)CameraMovement::Forward;
+    if (keys[SDL_SCANCODE_S]) movement |= (std::uint32_t)CameraMovement::Backward;
+    if (keys[SDL_SCANCODE_D]) movement |= (std::uint32_t)CameraMovement::Right;
+    if (keys[SDL_SCANCODE_A]) movement |= (std::uint32_t)CameraMovement::Left;
+    if (keys[SDL_SCANCODE_SPACE]) movement |= (std::uint32_t)CameraMovement::WorldUp;
+    if (keys[SDL_SCANCODE_LCTRL]) movement |= (std::uint32_t)CameraMovement::WorldDown;
+    return movement;
+}
+
 VulkanEngine &VulkanEngine::GetInstance() {
     return g_VkEngine;
 }
@@ -44,14 +64,19 @@ void VulkanEngine::init() {
         m_WindowExtent.height,
         windowFlags);
 
+    m_JobSystem.init();
+
     initVulkan();
     initSwapchain();
     initCommands();
     initSyncStructures();
+    initFrameAllocators();
     initDescriptors();
     initPipelines();
     initImGui();
     initDefaultData();
+    initShaderHotReload();
+    initSimulation();
 
     m_IsInitialized = true;
 }
@@ -61,12 +86,20 @@ void VulkanEngine::cleanup() {
 
     vkDeviceWaitIdle(m_Device);
 
+    m_Simulation.shutdown();
+    m_JobSystem.shutdown();
+    m_ShaderWatcher.shutdown();
+
+    for (const auto &[target, pipeline] : m_ReloadedPipelines) {
+        vkDestroyPipeline(m_Device, pipeline, nullptr);
+    }
+    m_ReloadedPipelines.clear();
+
     for (FrameData &frame : m_Frames) {
         vkDestroyCommandPool(m_Device, frame.CommandPool, nullptr);
         vkDestroyFence(m_Device, frame.RenderFence, nullptr);
         vkDestroySemaphore(m_Device, frame.SwapchainSemaphore, nullptr);
         vkDestroySemaphore(m_Device, frame.RenderSemaphore, nullptr);
-        frame.DeletionQueue.flush();
     }
 
     m_MainDeletionQueue.flush();
@@ -86,7 +119,12 @@ void VulkanEngine::draw() {
     FrameData &frame = getCurrentFrame();
 
     VK_CHECK(vkWaitForFences(m_Device, 1, &frame.RenderFence, VK_TRUE, 1000000000));
-    frame.DeletionQueue.flush();
+    frame.FrameDescriptors.clearPools(m_Device);
+    m_DeferredDeletionQueue.flush((std::uint64_t)m_FrameNumber);
+    frame.LinearAllocator.reset();
+    frame.Arena.reset();
+    m_BindlessHeap.beginFrame((std::uint64_t)m_FrameNumber);
+    applyReloadedPipelines();
     VK_CHECK(vkResetFences(m_Device, 1, &frame.RenderFence));
 
     std::uint32_t swapchainImageIndex;
@@ -110,23 +148,36 @@ void VulkanEngine::draw() {
     VkCommandBufferBeginInfo commandBufferBeginInfo = vkinit::GetCommandBufferBeginInfo(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
     VK_CHECK(vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo));
 
-    vkutils::TransitionImageLayout(commandBuffer, m_DrawImage.Image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL);
-    drawBackground(commandBuffer);
-    vkutils::TransitionImageLayout(commandBuffer, m_DrawImage.Image, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
-    vkutils::TransitionImageLayout(commandBuffer, m_DepthImage.Image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL);
-    drawGeometry(commandBuffer);
+    m_TextureStreamer.update(commandBuffer, (std::uint64_t)m_FrameNumber, frame.Arena.getResource());
+
+    m_RenderGraph.reset(frame.Arena.getResource());
 
-    vkutils::TransitionImageLayout(commandBuffer, m_DrawImage.Image, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
-    vkutils::TransitionImageLayout(commandBuffer, swapchainImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    vkutils::CopyImageToImage(commandBuffer, m_DrawImage.Image, swapchainImage, m_DrawExtent, m_SwapchainExtent);
+    const std::uint32_t drawImage = m_RenderGraph.importImage("DrawImage", m_DrawImage.Image, m_DrawImage.View, VK_IMAGE_ASPECT_COLOR_BIT);
+    const std::uint32_t depthImage = m_RenderGraph.createImage("DepthImage", RenderGraphImageDesc{.Format = m_DepthFormat, .Extent = VkExtent2D{m_DrawImage.Extent.width, m_DrawImage.Extent.height}});
+    const std::uint32_t frameData = m_RenderGraph.importBuffer("FrameData", frame.LinearAllocator.getBuffer());
+    const std::uint32_t swapchain = m_RenderGraph.importImage("Swapchain", swapchainImage, swapchainImageView, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT);
 
-    vkutils::TransitionImageLayout(commandBuffer, swapchainImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    m_RenderGraph.addPass("Clear", [&](VkCommandBuffer commandBuffer) { clearBackground(commandBuffer); })
+        .access(drawImage, RenderGraphUsage::TransferWrite);
+    m_RenderGraph.addPass("Background", [&](VkCommandBuffer commandBuffer) { drawBackground(commandBuffer); })
+        .access(drawImage, RenderGraphUsage::ComputeStorageWrite);
+    m_RenderGraph.addPass("Geometry", [&](VkCommandBuffer commandBuffer) { drawGeometry(commandBuffer, m_RenderGraph.getImageView(depthImage)); })
+        .access(drawImage, RenderGraphUsage::ColorAttachmentReadWrite)
+        .access(depthImage, RenderGraphUsage::DepthAttachmentWrite)
+        .access(frameData, RenderGraphUsage::VertexStorageRead);
+    m_RenderGraph.addPass("Blit", [&](VkCommandBuffer commandBuffer) { vkutils::CopyImageToImage(commandBuffer, m_DrawImage.Image, swapchainImage, m_DrawExtent, m_SwapchainExtent); })
+        .access(drawImage, RenderGraphUsage::TransferRead)
+        .access(swapchain, RenderGraphUsage::TransferWrite);
+    m_RenderGraph.addPass("ImGui", [&](VkCommandBuffer commandBuffer) { drawImGui(commandBuffer, swapchainImageView); })
+        .access(swapchain, RenderGraphUsage::ColorAttachmentReadWrite);
 
-    drawImGui(commandBuffer, swapchainImageView);
+    m_RenderGraph.execute(commandBuffer, (std::uint64_t)m_FrameNumber);
 
-    vkutils::TransitionImageLayout(commandBuffer, swapchainImage, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
     VK_CHECK(vkEndCommandBuffer(commandBuffer));
 
+    m_BindlessHeap.flush();
+    frame.LinearAllocator.flush();
+
     VkCommandBufferSubmitInfo commandBufferSubmitInfo = vkinit::GetCommandBufferSubmitInfo(commandBuffer);
     VkSemaphoreSubmitInfo waitInfo = vkinit::GetSemaphoreSubmitInfo(VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR, frame.SwapchainSemaphore);
     VkSemaphoreSubmitInfo signalInfo = vkinit::GetSemaphoreSubmitInfo(VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT, frame.RenderSemaphore);
@@ -156,15 +207,23 @@ void VulkanEngine::draw() {
     m_FrameNumber++;
 }
 
-void VulkanEngine::drawBackground(VkCommandBuffer commandBuffer) {
+void VulkanEngine::clearBackground(VkCommandBuffer commandBuffer) {
     VkClearColorValue clearValue{{0.0f, 0.0f, std::abs(std::sin(m_FrameNumber / 120.0f)), 1.0f}};
     VkImageSubresourceRange clearRange = vkinit::GetImageSubresourceRange(VK_IMAGE_ASPECT_COLOR_BIT);
-    vkCmdClearColorImage(commandBuffer, m_DrawImage.Image, VK_IMAGE_LAYOUT_GENERAL, &clearValue, 1, &clearRange);
+    vkCmdClearColorImage(commandBuffer, m_DrawImage.Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearValue, 1, &clearRange);
+}
 
+void VulkanEngine::drawBackground(VkCommandBuffer commandBuffer) {
     ComputeEffect &effect = m_BackgroundEffects[m_CurrentBackgroundEffect];
 
+    VkDescriptorSet drawImageDescriptors = getCurrentFrame().FrameDescriptors.allocate(m_Device, m_DrawImageDescriptorLayout);
+
+    DescriptorWriter writer{};
+    writer.writeImage(drawImageDescriptors, 0, m_DrawImage.View, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_GENERAL, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);
+    writer.flush(m_Device);
+
     vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, effect.Pipeline);
-    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, effect.Layout, 0, 1, &m_DrawImageDescriptors, 0, nullptr);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, effect.Layout, 0, 1, &drawImageDescriptors, 0, nullptr);
     vkCmdPushConstants(commandBuffer, m_GradientPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ComputePushConstants), &effect.Data);
     vkCmdDispatch(commandBuffer, std::ceil(m_DrawExtent.width / 16.0), std::ceil(m_DrawExtent.height / 16.0), 1);
 }
@@ -178,7 +237,7 @@ void VulkanEngine::drawImGui(VkCommandBuffer commandBuffer, VkImageView targetIm
     vkCmdEndRendering(commandBuffer);
 }
 
-void VulkanEngine::drawGeometry(VkCommandBuffer commandBuffer) {
+void VulkanEngine::drawGeometry(VkCommandBuffer commandBuffer, VkImageView depthImageView) {
     VkViewport viewport{
         .x = 0,
         .y = 0,
@@ -194,34 +253,145 @@ void VulkanEngine::drawGeometry(VkCommandBuffer commandBuffer) {
     };
 
     VkRenderingAttachmentInfo colorAttachment = vkinit::GetAttachmentInfo(m_DrawImage.View, nullptr);
-    VkRenderingAttachmentInfo depthAttachment = vkinit::GetDepthAttachmentInfo(m_DepthImage.View);
+    VkRenderingAttachmentInfo depthAttachment = vkinit::GetDepthAttachmentInfo(depthImageView);
 
     VkRenderingInfo renderInfo = vkinit::GetRenderingInfo(m_DrawExtent, colorAttachment, &depthAttachment);
     vkCmdBeginRendering(commandBuffer, &renderInfo);
 
     vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
     vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+    m_DynamicStateTracker.begin(commandBuffer);
 
     vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_TrianglePipeline);
+    m_DynamicStateTracker.apply(m_TriangleDynamicState);
     vkCmdDraw(commandBuffer, 3, 1, 0, 0);
 
-    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_MeshPipeline);
-    static GPUDrawPushConstants pushConstants{};
-    pushConstants.WorldMatrix = glm::mat4{1.0f};
-    pushConstants.VertexBuffer = m_Rectangle.VertexBufferAddress;
-    vkCmdPushConstants(commandBuffer, m_MeshPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(GPUDrawPushConstants), &pushConstants);
-    vkCmdBindIndexBuffer(commandBuffer, m_Rectangle.IndexBuffer.Buffer, 0, VK_INDEX_TYPE_UINT32);
-    vkCmdDrawIndexed(commandBuffer, 6, 1, 0, 0, 0);
-
-    glm::mat4 view = glm::translate(glm::vec3{0.0f, 0.0f, -5.0f});
+    FrameData &frame = getCurrentFrame();
+
+    constexpr float zNear{0.1f};
+    constexpr float zFar{10000.0f};
+
+    const SimulationSnapshot &snapshot = m_Simulation.acquireSnapshot();
+    const float alpha = m_Simulation.getInterpolationFactor(snapshot);
+
+    glm::mat4 view = simulation::InterpolateView(snapshot, alpha);
     // glm::mat4 projection = glm::perspective(glm::radians(70.0f), (float)m_DrawExtent.width / (float)m_DrawExtent.height, 10000.0f, 0.1f);
-    glm::mat4 projection = glm::perspective(glm::radians(70.0f), (float)m_DrawExtent.width / (float)m_DrawExtent.height, 0.1f, 10000.0f);
+    glm::mat4 projection = glm::perspective(glm::radians(70.0f), (float)m_DrawExtent.width / (float)m_DrawExtent.height, zNear, zFar);
     projection[1][1] *= -1;
-    pushConstants.WorldMatrix = projection * view;
-    pushConstants.VertexBuffer = m_TestMeshes[2]->MeshBuffers.VertexBufferAddress;
-    vkCmdPushConstants(commandBuffer, m_MeshPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(GPUDrawPushConstants), &pushConstants);
-    vkCmdBindIndexBuffer(commandBuffer, m_TestMeshes[2]->MeshBuffers.IndexBuffer.Buffer, 0, VK_INDEX_TYPE_UINT32);
-    vkCmdDrawIndexed(commandBuffer, m_TestMeshes[2]->Surfaces[0].Count, 1, m_TestMeshes[2]->Surfaces[0].StartIndex, 0, 0);
+
+    std::optional<FrameAllocation> sceneData = frame.LinearAllocator.allocateArray<GPUSceneData>(1);
+    if (!sceneData.has_value()) {
+        vkCmdEndRendering(commandBuffer);
+        return;
+    }
+
+    *(GPUSceneData *)sceneData->Data = GPUSceneData{
+        .View = view,
+        .Projection = projection,
+        .ViewProjection = projection * view,
+    };
+
+    VkDescriptorSet sceneDescriptors = frame.FrameDescriptors.allocate(m_Device, m_SceneDataDescriptorLayout);
+
+    DescriptorWriter writer{};
+    writer.writeBuffer(sceneDescriptors, 0, sceneData->Buffer, sizeof(GPUSceneData), sceneData->Offset, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+    writer.flush(m_Device);
+
+    const GPUMeshBuffers *rectangle = m_ResourcePools.getMesh(m_Rectangle);
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_MeshPipeline);
+    m_DynamicStateTracker.apply(m_MeshDynamicState);
+    m_BindlessHeap.bind(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_MeshPipelineLayout);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_MeshPipelineLayout, 1, 1, &sceneDescriptors, 0, nullptr);
+    if (rectangle != nullptr) {
+        if (std::optional<FrameAllocation> rectangleInstance = frame.LinearAllocator.allocateArray<GPUInstanceData>(1)) {
+            // The rectangle is authored in clip space, undo the camera so it stays fixed on screen.
+            *(GPUInstanceData *)rectangleInstance->Data = GPUInstanceData{
+                .WorldMatrix = glm::inverse(projection * view),
+                .TextureIndex = m_WhiteImageIndex,
+                .SamplerIndex = m_DefaultSamplerIndex,
+            };
+            GPUDrawPushConstants pushConstants{
+                .VertexBuffer = rectangle->VertexBufferAddress,
+                .InstanceBuffer = rectangleInstance->Address,
+            };
+            vkCmdPushConstants(commandBuffer, m_MeshPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(GPUDrawPushConstants), &pushConstants);
+            vkCmdBindIndexBuffer(commandBuffer, rectangle->IndexBuffer.Buffer, 0, VK_INDEX_TYPE_UINT32);
+            vkCmdDrawIndexed(commandBuffer, 6, 1, 0, 0, 0);
+        }
+    }
+
+    const float focalLength = (float)m_DrawExtent.height / (2.0f * std::tan(glm::radians(70.0f) * 0.5f));
+
+    m_RenderList.clear();
+
+    const std::uint32_t meshPipelineId = m_RenderList.getPipelineId(m_MeshPipeline);
+    const std::uint32_t nodeCount = std::min(m_Scene.Graph.getNodeCount(), (std::uint32_t)snapshot.WorldMatrices.size());
+    for (std::uint32_t node = 0; node < nodeCount; node++) {
+        const std::int32_t meshIndex = m_Scene.Graph.getMeshIndex(node);
+        if (meshIndex == SCENE_NO_MESH) continue;
+
+        const std::shared_ptr<MeshAsset> &mesh = m_Scene.Meshes[meshIndex];
+        const GPUMeshBuffers *meshBuffers = m_ResourcePools.getMesh(mesh->Mesh);
+        if (meshBuffers == nullptr) continue;
+
+        const glm::mat4 worldMatrix = simulation::InterpolateWorldMatrix(snapshot, node, alpha);
+        const float viewDepth = -(view * worldMatrix[3]).z;
+        const float worldScale = std::max({glm::length(glm::vec3{worldMatrix[0]}), glm::length(glm::vec3{worldMatrix[1]}), glm::length(glm::vec3{worldMatrix[2]})});
+
+        for (const GeoSurface &surface : mesh->Surfaces) {
+            std::uint32_t textureIndex = m_WhiteImageIndex;
+            if (surface.ImageIndex != SURFACE_NO_IMAGE && m_Scene.Textures[surface.ImageIndex] != STREAMING_INVALID_TEXTURE) {
+                const std::uint32_t texture = m_Scene.Textures[surface.ImageIndex];
+                if (viewDepth > 0.0f) {
+                    m_TextureStreamer.requestTexelDensity(texture, surface.UvDensity / std::max(worldScale, 1e-6f), focalLength / std::max(viewDepth, zNear));
+                }
+
+                const std::uint32_t bindlessIndex = m_TextureStreamer.getBindlessIndex(texture);
+                if (bindlessIndex != BINDLESS_INVALID_INDEX) textureIndex = bindlessIndex;
+            }
+
+            std::uint32_t samplerIndex = m_DefaultSamplerIndex;
+            if (surface.SamplerIndex != SURFACE_NO_SAMPLER && m_Scene.Samplers[surface.SamplerIndex] != BINDLESS_INVALID_INDEX) {
+                samplerIndex = m_Scene.Samplers[surface.SamplerIndex];
+            }
+
+            const std::uint32_t meshId = m_RenderList.getMeshId(meshBuffers->IndexBuffer.Buffer, surface.StartIndex);
+            const std::uint64_t sortKey = drawkey::Make(RenderPassType::Opaque, meshPipelineId, 0, meshId, viewDepth / zFar);
+
+            m_RenderList.add(
+                RenderObject{
+                    .IndexCount = surface.Count,
+                    .FirstIndex = surface.StartIndex,
+                    .IndexBuffer = meshBuffers->IndexBuffer.Buffer,
+                    .VertexBufferAddress = meshBuffers->VertexBufferAddress,
+                    .Pipeline = m_MeshPipeline,
+                    .Layout = m_MeshPipelineLayout,
+                    .DynamicState = &m_MeshDynamicState,
+                    .Transform = worldMatrix,
+                    .TextureIndex = textureIndex,
+                    .SamplerIndex = samplerIndex,
+                },
+                sortKey);
+        }
+    }
+
+    m_RenderList.sort(&m_JobSystem, frame.Arena.getWorkerResource(JobSystem::GetCurrentWorkerIndex()));
+
+    const std::uint32_t instanceCount = std::min(m_RenderList.getObjectCount(), MAX_INSTANCES_PER_FRAME);
+    std::optional<FrameAllocation> instances{};
+    if (instanceCount > 0) {
+        instances = frame.LinearAllocator.allocateArray<GPUInstanceData>(instanceCount);
+    }
+    m_DrawStats = m_RenderList.submit(
+        commandBuffer,
+        &m_DynamicStateTracker,
+        InstanceBufferView{
+            .Data = instances.has_value() ? (GPUInstanceData *)instances->Data : nullptr,
+            .Address = instances.has_value() ? instances->Address : 0,
+            .First = 0,
+            .Capacity = instances.has_value() ? instanceCount : 0,
+        });
 
     vkCmdEndRendering(commandBuffer);
 }
@@ -246,9 +416,16 @@ void VulkanEngine::immediateSubmit(std::function<void(VkCommandBuffer commandBuf
 }
 
 void VulkanEngine::destroyBuffer(const AllocatedBuffer &buffer) {
+    m_MemoryTelemetry.untrack(buffer.Allocation);
     vmaDestroyBuffer(m_Allocator, buffer.Buffer, buffer.Allocation);
 }
 
+void VulkanEngine::destroyImage(const AllocatedImage &image) {
+    vkDestroyImageView(m_Device, image.View, nullptr);
+    m_MemoryTelemetry.untrack(image.Allocation);
+    vmaDestroyImage(m_Allocator, image.Image, image.Allocation);
+}
+
 void VulkanEngine::run() {
     SDL_Event e{0};
     bool quit{false};
@@ -266,9 +443,15 @@ void VulkanEngine::run() {
                     m_StopRendering = false;
             }
 
+            if (e.type == SDL_MOUSEMOTION && (e.motion.state & SDL_BUTTON_RMASK) && !ImGui::GetIO().WantCaptureMouse) {
+                m_Simulation.addMouseMotion((float)e.motion.xrel, (float)e.motion.yrel);
+            }
+
             ImGui_ImplSDL2_ProcessEvent(&e);
         }
 
+        m_Simulation.setMovement(m_StopRendering || ImGui::GetIO().WantCaptureKeyboard ? 0 : getCameraMovement());
+
         if (m_StopRendering) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
             continue;
@@ -278,6 +461,8 @@ void VulkanEngine::run() {
             resizeSwapchain();
         }
 
+        pollShaderChanges();
+
         ImGui_ImplVulkan_NewFrame();
         ImGui_ImplSDL2_NewFrame();
         ImGui::NewFrame();
@@ -298,6 +483,109 @@ void VulkanEngine::run() {
         }
         ImGui::End();
 
+        if (ImGui::Begin("Memory")) {
+            ImGui::Text("Memory budget extension: %s", m_MemoryTelemetry.hasMemoryBudget() ? "enabled" : "unavailable");
+            const std::vector<MemoryHeapStats> heaps = m_MemoryTelemetry.getHeapStats();
+            for (std::size_t heap = 0; heap < heaps.size(); heap++) {
+                const MemoryHeapStats &stats = heaps[heap];
+                ImGui::Text("Heap %zu (%s): %.2f / %.2f MB (%.2f MB heap)",
+                            heap,
+                            (stats.Flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) ? "device" : "host",
+                            stats.Usage / (1024.0 * 1024.0),
+                            stats.Budget / (1024.0 * 1024.0),
+                            stats.Size / (1024.0 * 1024.0));
+                ImGui::Text("    %u blocks %.2f MB, %u allocations %.2f MB",
+                            stats.BlockCount,
+                            stats.BlockBytes / (1024.0 * 1024.0),
+                            stats.AllocationCount,
+                            stats.AllocationBytes / (1024.0 * 1024.0));
+            }
+            for (std::size_t i = 0; i < MEMORY_CATEGORY_COUNT; i++) {
+                const MemoryCategoryStats stats = m_MemoryTelemetry.getCategoryStats((MemoryCategory)i);
+                ImGui::Text("%s: %u allocations, %.2f MB (peak %.2f MB)",
+                            vkutils::GetMemoryCategoryName((MemoryCategory)i),
+                            stats.AllocationCount,
+                            stats.AllocationBytes / (1024.0 * 1024.0),
+                            stats.PeakBytes / (1024.0 * 1024.0));
+            }
+            const DeferredDeletionStats &deletionStats = m_DeferredDeletionQueue.getStats();
+            const ResourcePoolStats poolStats = m_ResourcePools.getStats();
+            ImGui::Text("Resource pools: %u images, %u meshes, %u stale handles",
+                        poolStats.ImageCount,
+                        poolStats.MeshCount,
+                        poolStats.StaleLookupCount);
+            ImGui::Text("Deferred deletions: %u pending, %u destroyed, %u closures",
+                        deletionStats.PendingCount,
+                        deletionStats.DestroyedCount,
+                        deletionStats.FunctionCount);
+            if (ImGui::Button("Write stats JSON")) {
+                m_MemoryTelemetry.writeStats(MEMORY_STATS_PATH);
+            }
+        }
+        ImGui::End();
+
+        if (ImGui::Begin("Stats")) {
+            ImGui::Text("Render objects: %u", m_DrawStats.ObjectCount);
+            ImGui::Text("Draw calls: %u", m_DrawStats.DrawCalls);
+            ImGui::Text("Instances: %u (dropped %u)", m_DrawStats.InstanceCount, m_DrawStats.DroppedObjects);
+            ImGui::Text("Pipeline binds: %u (skipped %u)", m_DrawStats.PipelineBinds, m_DrawStats.SkippedPipelineBinds);
+            ImGui::Text("Index buffer binds: %u (skipped %u)", m_DrawStats.IndexBufferBinds, m_DrawStats.SkippedIndexBufferBinds);
+            ImGui::Text("Push constant updates: %u", m_DrawStats.PushConstantUpdates);
+            ImGui::Text("Dynamic state changes: %u", m_DrawStats.DynamicStateChanges);
+            const FrameAllocatorStats &frameAllocatorStats = getCurrentFrame().LinearAllocator.getStats();
+            ImGui::Text("Frame allocator: %.2f / %.2f KB (peak %.2f KB), %u allocations, %u failed, %s",
+                        frameAllocatorStats.UsedBytes / 1024.0,
+                        frameAllocatorStats.Capacity / 1024.0,
+                        frameAllocatorStats.PeakBytes / 1024.0,
+                        frameAllocatorStats.AllocationCount,
+                        frameAllocatorStats.FailedCount,
+                        frameAllocatorStats.IsDeviceLocal ? "device-local" : "host");
+            ImGui::Text("Mesh uploads: %u direct (%.2f MB), %u staged (%.2f MB)",
+                        m_MeshUploadStats.DirectBufferCount,
+                        m_MeshUploadStats.DirectBytes / (1024.0 * 1024.0),
+                        m_MeshUploadStats.StagedBufferCount,
+                        m_MeshUploadStats.StagedBytes / (1024.0 * 1024.0));
+            const FrameArenaStats frameArenaStats = getCurrentFrame().Arena.getStats();
+            ImGui::Text("Frame arena: %.2f / %.2f KB (high water %.2f KB), %u allocations, %u heap allocations",
+                        frameArenaStats.UsedBytes / 1024.0,
+                        frameArenaStats.Capacity / 1024.0,
+                        frameArenaStats.HighWaterMark / 1024.0,
+                        frameArenaStats.AllocationCount,
+                        frameArenaStats.HeapAllocationCount);
+            const SimulationStats &simulationStats = m_Simulation.getSnapshot().Stats;
+            ImGui::Text("Simulation: %.0f Hz, %llu ticks (skipped %llu), tick time %.3f ms (avg %.3f ms)",
+                        m_Simulation.getTickRate(),
+                        (unsigned long long)simulationStats.TickCount,
+                        (unsigned long long)simulationStats.SkippedTickCount,
+                        simulationStats.TickTime,
+                        simulationStats.AverageTickTime);
+            ImGui::Text("Pipeline variants: %u (hits %u, misses %u)", m_PipelineVariants.getVariantCount(), m_PipelineVariants.getHitCount(), m_PipelineVariants.getMissCount());
+            ImGui::Text("Full compile: %.3f ms", m_PipelineCompiler.getAverageCompileTime());
+            const RenderGraphStats &graphStats = m_RenderGraph.getStats();
+            ImGui::Text("Render graph passes: %u (culled %u), barriers: %u in %u batches", graphStats.PassCount, graphStats.CulledPassCount, graphStats.BarrierCount, graphStats.BarrierBatchCount);
+            ImGui::Text("Transient images: %u in %u blocks, %.2f MB (aliased %.2f MB)",
+                        graphStats.TransientImageCount,
+                        graphStats.TransientBlockCount,
+                        graphStats.TransientBytes / (1024.0 * 1024.0),
+                        graphStats.TransientAliasedBytes / (1024.0 * 1024.0));
+            ImGui::Text("Dynamic state sets: %u (skipped %u)", m_DynamicStateTracker.getSetCount(), m_DynamicStateTracker.getSkippedCount());
+            ImGui::Text("Textures: %u (failed %u), samplers: %u", m_TextureStats.TextureCount, m_TextureStats.FailedCount, m_SamplerCache.getSamplerCount());
+            ImGui::Text("Compressed textures: %u (cached %u), %.2f MB uploaded", m_TextureStats.CompressedCount, m_TextureStats.CachedCount, m_TextureStats.UploadedBytes / (1024.0 * 1024.0));
+            ImGui::Text("Texture decode: %.2f ms, upload: %.2f ms", m_TextureStats.DecodeTime, m_TextureStats.UploadTime);
+            const StreamingStats &streamingStats = m_TextureStreamer.getStats();
+            ImGui::Text("Streamed textures: %u (fully resident %u, pending %u)", streamingStats.TextureCount, streamingStats.FullyResidentCount, streamingStats.PendingCount);
+            ImGui::Text("Texture residency: %.2f / %.2f MB", streamingStats.ResidentBytes / (1024.0 * 1024.0), streamingStats.BudgetBytes / (1024.0 * 1024.0));
+            ImGui::Text("Streaming uploads: %u, %.2f MB", streamingStats.UploadCount, streamingStats.UploadedBytes / (1024.0 * 1024.0));
+            ImGui::Text("Streaming evictions: %u, %.2f MB freed", streamingStats.EvictionCount, streamingStats.EvictedBytes / (1024.0 * 1024.0));
+            if (m_PipelineLibraryLinker.hasFastLinking()) {
+                ImGui::Text("Pipeline libraries: %u", m_PipelineLibraryLinker.getLibraryCount());
+                ImGui::Text("Fast link: %.3f ms, optimized link: %.3f ms", m_PipelineLibraryLinker.getAverageLinkTime(), m_PipelineLibraryLinker.getAverageOptimizedLinkTime());
+            } else if (m_PipelineLibraryLinker.isSupported()) {
+                ImGui::Text("Pipeline libraries: no fast linking, using full compiles");
+            }
+        }
+        ImGui::End();
+
         ImGui::Render();
         ImGui::EndFrame();
 
@@ -325,6 +613,12 @@ void VulkanEngine::initVulkan() {
             .set_required_features_12(VkPhysicalDeviceVulkan12Features{
                 .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
                 .descriptorIndexing = true,
+                .shaderSampledImageArrayNonUniformIndexing = true,
+                .shaderStorageBufferArrayNonUniformIndexing = true,
+                .descriptorBindingSampledImageUpdateAfterBind = true,
+                .descriptorBindingStorageBufferUpdateAfterBind = true,
+                .descriptorBindingPartiallyBound = true,
+                .runtimeDescriptorArray = true,
                 .bufferDeviceAddress = true,
             })
             .set_required_features_13(VkPhysicalDeviceVulkan13Features{
@@ -337,9 +631,75 @@ void VulkanEngine::initVulkan() {
     assert(vkbPhysicalDeviceResult.has_value());
     vkb::PhysicalDevice vkbPhysicalDevice{vkbPhysicalDeviceResult.value()};
 
-    vkb::Result<vkb::Device> vkbDeviceResult =
-        vkb::DeviceBuilder{vkbPhysicalDevice}
-            .build();
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT graphicsPipelineLibraryFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT,
+    };
+    if (vkbPhysicalDevice.enable_extension_if_present(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME) &&
+        vkbPhysicalDevice.enable_extension_if_present(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME)) {
+        VkPhysicalDeviceFeatures2 features{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+            .pNext = &graphicsPipelineLibraryFeatures,
+        };
+        vkGetPhysicalDeviceFeatures2(vkbPhysicalDevice, &features);
+
+        VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT graphicsPipelineLibraryProperties{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT,
+        };
+        VkPhysicalDeviceProperties2 properties{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+            .pNext = &graphicsPipelineLibraryProperties,
+        };
+        vkGetPhysicalDeviceProperties2(vkbPhysicalDevice, &properties);
+
+        m_DeviceCapabilities.GraphicsPipelineLibrary = graphicsPipelineLibraryFeatures.graphicsPipelineLibrary;
+        m_DeviceCapabilities.GraphicsPipelineLibraryFastLinking = graphicsPipelineLibraryProperties.graphicsPipelineLibraryFastLinking;
+    }
+
+    VkPhysicalDeviceExtendedDynamicState3FeaturesEXT extendedDynamicState3Features{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT,
+    };
+    if (vkbPhysicalDevice.enable_extension_if_present(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME)) {
+        VkPhysicalDeviceFeatures2 features{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+            .pNext = &extendedDynamicState3Features,
+        };
+        vkGetPhysicalDeviceFeatures2(vkbPhysicalDevice, &features);
+
+        m_DeviceCapabilities.ExtendedDynamicState3Blend = extendedDynamicState3Features.extendedDynamicState3ColorBlendEnable &&
+                                                          extendedDynamicState3Features.extendedDynamicState3ColorBlendEquation &&
+                                                          extendedDynamicState3Features.extendedDynamicState3ColorWriteMask;
+        extendedDynamicState3Features = VkPhysicalDeviceExtendedDynamicState3FeaturesEXT{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT,
+            .extendedDynamicState3ColorBlendEnable = m_DeviceCapabilities.ExtendedDynamicState3Blend,
+            .extendedDynamicState3ColorBlendEquation = m_DeviceCapabilities.ExtendedDynamicState3Blend,
+            .extendedDynamicState3ColorWriteMask = m_DeviceCapabilities.ExtendedDynamicState3Blend,
+        };
+    }
+
+    m_DeviceCapabilities.MemoryBudget = vkbPhysicalDevice.enable_extension_if_present(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+    if (g_UseTextureCompression) {
+        m_DeviceCapabilities.TextureCompressionBC = vkbPhysicalDevice.enable_features_if_present(VkPhysicalDeviceFeatures{
+            .textureCompressionBC = true,
+        });
+    }
+
+    vkb::DeviceBuilder vkbDeviceBuilder{vkbPhysicalDevice};
+    if (m_DeviceCapabilities.GraphicsPipelineLibrary) {
+        vkbDeviceBuilder.add_pNext(&graphicsPipelineLibraryFeatures);
+    }
+    if (m_DeviceCapabilities.ExtendedDynamicState3Blend) {
+        vkbDeviceBuilder.add_pNext(&extendedDynamicState3Features);
+    }
+
+    fmt::println("[INFO]: Graphics pipeline library: {} (fast linking: {}).",
+                  m_DeviceCapabilities.GraphicsPipelineLibrary,
+                  m_DeviceCapabilities.GraphicsPipelineLibraryFastLinking);
+    fmt::println("[INFO]: Extended dynamic state 3 blending: {}.", m_DeviceCapabilities.ExtendedDynamicState3Blend);
+    fmt::println("[INFO]: BC texture compression: {}.", m_DeviceCapabilities.TextureCompressionBC);
+    fmt::println("[INFO]: Memory budget: {}.", m_DeviceCapabilities.MemoryBudget);
+
+    vkb::Result<vkb::Device> vkbDeviceResult = vkbDeviceBuilder.build();
     assert(vkbDeviceResult.has_value());
     vkb::Device vkbDevice{vkbDeviceResult.value()};
     vkb::Result<VkQueue> graphicsQueueResult = vkbDevice.get_queue(vkb::QueueType::graphics);
@@ -354,17 +714,37 @@ void VulkanEngine::initVulkan() {
     m_GraphicsQueue = graphicsQueueResult.value();
     m_GraphicsQueueIndex = graphicsQueueIndexResult.value();
 
+    m_CompressedFormatSupport = vkutils::GetCompressedFormatSupport(m_PhysicalDevice, m_DeviceCapabilities.TextureCompressionBC);
+
+    VmaAllocatorCreateFlags allocatorFlags = VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT;
+    if (m_DeviceCapabilities.MemoryBudget) {
+        allocatorFlags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+    }
+
     VmaAllocatorCreateInfo allocatorInfo{
-        .flags = VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT,
+        .flags = allocatorFlags,
         .physicalDevice = m_PhysicalDevice,
         .device = m_Device,
         .instance = m_Instance,
+        .vulkanApiVersion = VK_API_VERSION_1_3,
     };
     vmaCreateAllocator(&allocatorInfo, &m_Allocator);
+    m_MemoryTelemetry.init(m_Allocator, m_DeviceCapabilities.MemoryBudget);
+    m_DeferredDeletionQueue.init(m_Device, m_Allocator, &m_MemoryTelemetry, FRAME_OVERLAP);
+    m_ResourcePools.init(m_Device, m_Allocator, &m_MemoryTelemetry, &m_DeferredDeletionQueue);
 
     m_MainDeletionQueue.pushFunction([this]() {
         vmaDestroyAllocator(m_Allocator);
     });
+    m_MainDeletionQueue.pushFunction([this]() {
+        m_MemoryTelemetry.destroy();
+    });
+    m_MainDeletionQueue.pushFunction([this]() {
+        m_DeferredDeletionQueue.destroy();
+    });
+    m_MainDeletionQueue.pushFunction([this]() {
+        m_ResourcePools.destroy();
+    });
 }
 
 void VulkanEngine::initSwapchain() {
@@ -390,22 +770,18 @@ void VulkanEngine::initSwapchain() {
         VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
     VkImageCreateInfo rImageInfo = vkinit::GetImageCreateInfo(m_DrawImage.Format, drawImageUsages, imageExtent);
     vmaCreateImage(m_Allocator, &rImageInfo, &imageAllocationInfo, &m_DrawImage.Image, &m_DrawImage.Allocation, nullptr);
+    m_MemoryTelemetry.track(m_DrawImage.Allocation, MemoryCategory::RenderTarget);
     VkImageViewCreateInfo rImageViewInfo = vkinit::GetImageViewCreateInfo(m_DrawImage.Format, m_DrawImage.Image, VK_IMAGE_ASPECT_COLOR_BIT);
     VK_CHECK(vkCreateImageView(m_Device, &rImageViewInfo, nullptr, &m_DrawImage.View));
 
-    m_DepthImage.Extent = imageExtent;
-    m_DepthImage.Format = VK_FORMAT_D32_SFLOAT;
-    VkImageUsageFlags depthImageUsages{VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT};
-    VkImageCreateInfo dImageInfo = vkinit::GetImageCreateInfo(m_DepthImage.Format, depthImageUsages, imageExtent);
-    vmaCreateImage(m_Allocator, &dImageInfo, &imageAllocationInfo, &m_DepthImage.Image, &m_DepthImage.Allocation, nullptr);
-    VkImageViewCreateInfo dImageViewInfo = vkinit::GetImageViewCreateInfo(m_DepthImage.Format, m_DepthImage.Image, VK_IMAGE_ASPECT_DEPTH_BIT);
-    VK_CHECK(vkCreateImageView(m_Device, &dImageViewInfo, nullptr, &m_DepthImage.View));
+    m_RenderGraph.init(m_Device, m_Allocator, &m_MemoryTelemetry, FRAME_OVERLAP);
 
     m_MainDeletionQueue.pushFunction([this]() {
+        m_RenderGraph.destroy();
+
         vkDestroyImageView(m_Device, m_DrawImage.View, nullptr);
-        vkDestroyImageView(m_Device, m_DepthImage.View, nullptr);
+        m_MemoryTelemetry.untrack(m_DrawImage.Allocation);
         vmaDestroyImage(m_Allocator, m_DrawImage.Image, m_DrawImage.Allocation);
-        vmaDestroyImage(m_Allocator, m_DepthImage.Image, m_DepthImage.Allocation);
     });
 }
 
@@ -448,13 +824,44 @@ void VulkanEngine::initSyncStructures() {
     });
 }
 
+void VulkanEngine::initFrameAllocators() {
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(m_PhysicalDevice, &properties);
+
+    const VkDeviceSize alignment = std::max(properties.limits.minUniformBufferOffsetAlignment, properties.limits.minStorageBufferOffsetAlignment);
+    for (FrameData &frame : m_Frames) {
+        frame.LinearAllocator.init(m_Device, m_Allocator, &m_MemoryTelemetry, FRAME_ALLOCATOR_CAPACITY, alignment);
+        frame.Arena.init(m_JobSystem.getWorkerCount());
+    }
+
+    m_MainDeletionQueue.pushFunction([this]() {
+        for (FrameData &frame : m_Frames) {
+            frame.LinearAllocator.destroy();
+            frame.Arena.destroy();
+        }
+    });
+}
+
 void VulkanEngine::initDescriptors() {
-    std::vector<DescriptorAllocator::PoolSizeRatio> sizeRatios{DescriptorAllocator::PoolSizeRatio{
-        .Type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
-        .Ratio = 1,
-    }};
+    std::vector<DescriptorAllocatorGrowable::PoolSizeRatio> frameSizeRatios{
+        DescriptorAllocatorGrowable::PoolSizeRatio{.Type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, .Ratio = 3},
+        DescriptorAllocatorGrowable::PoolSizeRatio{.Type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, .Ratio = 3},
+        DescriptorAllocatorGrowable::PoolSizeRatio{.Type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, .Ratio = 3},
+        DescriptorAllocatorGrowable::PoolSizeRatio{.Type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .Ratio = 4},
+    };
+
+    for (FrameData &frame : m_Frames) {
+        frame.FrameDescriptors.init(m_Device, 1000, frameSizeRatios);
 
-    m_GlobalDescriptorAllocator.initPool(m_Device, 10, sizeRatios);
+        m_MainDeletionQueue.pushFunction([this, &frame]() {
+            frame.FrameDescriptors.destroyPools(m_Device);
+        });
+    }
+
+    m_BindlessHeap.init(m_Device, m_PhysicalDevice, FRAME_OVERLAP);
+    m_MainDeletionQueue.pushFunction([this]() {
+        m_BindlessHeap.destroy();
+    });
 
     {
         DescriptorLayoutBuilder builder{};
@@ -462,34 +869,62 @@ void VulkanEngine::initDescriptors() {
         m_DrawImageDescriptorLayout = builder.build(m_Device, VK_SHADER_STAGE_COMPUTE_BIT);
     }
 
-    m_DrawImageDescriptors = m_GlobalDescriptorAllocator.allocate(m_Device, m_DrawImageDescriptorLayout);
-
-    VkDescriptorImageInfo imageInfo{
-        .imageView = m_DrawImage.View,
-        .imageLayout = VK_IMAGE_LAYOUT_GENERAL,
-    };
-
-    VkWriteDescriptorSet drawImageWrite{
-        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-        .dstSet = m_DrawImageDescriptors,
-        .dstBinding = 0,
-        .descriptorCount = 1,
-        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
-        .pImageInfo = &imageInfo,
-    };
-
-    vkUpdateDescriptorSets(m_Device, 1, &drawImageWrite, 0, nullptr);
+    {
+        DescriptorLayoutBuilder builder{};
+        builder.addBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+        m_SceneDataDescriptorLayout = builder.build(m_Device, VK_SHADER_STAGE_VERTEX_BIT);
+    }
 
     m_MainDeletionQueue.pushFunction([this]() {
-        m_GlobalDescriptorAllocator.destroyPool(m_Device);
         vkDestroyDescriptorSetLayout(m_Device, m_DrawImageDescriptorLayout, nullptr);
+        vkDestroyDescriptorSetLayout(m_Device, m_SceneDataDescriptorLayout, nullptr);
     });
 }
 
 void VulkanEngine::initPipelines() {
+    if (g_UseExtendedDynamicState) {
+        DynamicStateFlags dynamicStateFlags = DYNAMIC_STATE_RASTERIZATION | DYNAMIC_STATE_DEPTH;
+        if (m_DeviceCapabilities.ExtendedDynamicState3Blend) dynamicStateFlags |= DYNAMIC_STATE_BLEND;
+        m_DynamicStateTracker.init(m_Device, dynamicStateFlags);
+    }
+
+    m_PipelineCache.init(m_Device, m_PhysicalDevice, "Cache");
+    m_MainDeletionQueue.pushFunction([this]() {
+        m_PipelineCache.save();
+        m_PipelineCache.destroy();
+    });
+
+    if (!m_ShaderArchive.open("Assets/Shaders.pak")) {
+        fmt::println("[INFO]: Shader archive is not available, loading loose SPIR-V files.");
+    }
+    m_ShaderModuleCache.init(m_Device, &m_ShaderArchive);
+    m_MainDeletionQueue.pushFunction([this]() {
+        m_ShaderModuleCache.destroy();
+        m_ShaderArchive.close();
+    });
+
+    m_PipelineCompiler.init(m_Device, m_PipelineCache.get(), &m_JobSystem);
+    m_PipelineLibraryLinker.init(m_Device, m_PipelineCache.get(), m_DeviceCapabilities.GraphicsPipelineLibrary, m_DeviceCapabilities.GraphicsPipelineLibraryFastLinking);
+    m_PipelineVariants.init(m_Device, &m_PipelineCompiler, &m_PipelineLibraryLinker);
+    m_MainDeletionQueue.pushFunction([this]() {
+        m_PipelineVariants.destroy();
+        m_PipelineLibraryLinker.destroy();
+    });
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
     initBackgroundPipelines();
     initTrianglePipeline();
     initMeshPipeline();
+
+    m_PipelineCompiler.waitIdle();
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+    fmt::println("[INFO]: Compiled {} pipelines on {} threads.", m_PipelineCompiler.getSubmittedCount(), m_JobSystem.getWorkerCount() + 1);
+    if (m_ShaderModuleCache.getLooseOverrideCount() > 0) {
+        fmt::println("[INFO]: Loaded {} SPIR-V files that are newer than the shader archive.", m_ShaderModuleCache.getLooseOverrideCount());
+    }
+    m_PipelineCache.recordCreationTime(elapsed.count());
 }
 
 void VulkanEngine::initBackgroundPipelines() {
@@ -509,8 +944,8 @@ void VulkanEngine::initBackgroundPipelines() {
 
     VkShaderModule gradientShaderModule{VK_NULL_HANDLE};
     VkShaderModule skyShaderModule{VK_NULL_HANDLE};
-    assert(vkutils::LoadShaderModule(m_Device, "Assets/Shaders/GradientColor.comp.spv", &gradientShaderModule));
-    assert(vkutils::LoadShaderModule(m_Device, "Assets/Shaders/Sky.comp.spv", &skyShaderModule));
+    assert(m_ShaderModuleCache.getShaderModule("Assets/Shaders/GradientColor.comp.spv", &gradientShaderModule));
+    assert(m_ShaderModuleCache.getShaderModule("Assets/Shaders/Sky.comp.spv", &skyShaderModule));
 
     VkComputePipelineCreateInfo computePipelineInfo{
         .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
@@ -532,23 +967,35 @@ void VulkanEngine::initBackgroundPipelines() {
         },
     };
 
-    VK_CHECK(vkCreateComputePipelines(m_Device, VK_NULL_HANDLE, 1, &computePipelineInfo, nullptr, &gradient.Pipeline));
-
-    computePipelineInfo.stage.module = skyShaderModule;
-
     ComputeEffect sky{
         .Name = "Sky",
         .Layout = m_GradientPipelineLayout,
         .Data = ComputePushConstants{.Data1 = glm::vec4{0.1, 0.2, 0.4, 0.97}},
     };
 
-    VK_CHECK(vkCreateComputePipelines(m_Device, VK_NULL_HANDLE, 1, &computePipelineInfo, nullptr, &sky.Pipeline));
-
     m_BackgroundEffects.emplace_back(gradient);
     m_BackgroundEffects.emplace_back(sky);
 
-    vkDestroyShaderModule(m_Device, gradientShaderModule, nullptr);
-    vkDestroyShaderModule(m_Device, skyShaderModule, nullptr);
+    m_PipelineCompiler.compileCompute(computePipelineInfo, &m_BackgroundEffects[0].Pipeline);
+    computePipelineInfo.stage.module = skyShaderModule;
+    m_PipelineCompiler.compileCompute(computePipelineInfo, &m_BackgroundEffects[1].Pipeline);
+
+    auto registerEffect = [this, computePipelineInfo](const char *shaderPath, VkPipeline *target) {
+        registerReloadablePipeline(ReloadablePipeline{
+            .ShaderPaths = {shaderPath},
+            .Build = [this, computePipelineInfo](std::span<const VkShaderModule> shaderModules) {
+                VkComputePipelineCreateInfo info{computePipelineInfo};
+                info.stage.module = shaderModules[0];
+
+                VkPipeline pipeline{VK_NULL_HANDLE};
+                VK_CHECK(vkCreateComputePipelines(m_Device, m_PipelineCache.get(), 1, &info, nullptr, &pipeline));
+                return pipeline;
+            },
+            .Target = target,
+        });
+    };
+    registerEffect("Assets/Shaders/GradientColor.comp.spv", &m_BackgroundEffects[0].Pipeline);
+    registerEffect("Assets/Shaders/Sky.comp.spv", &m_BackgroundEffects[1].Pipeline);
 
     m_MainDeletionQueue.pushFunction([this]() {
         for (const ComputeEffect &computeEffect : m_BackgroundEffects) {
@@ -561,8 +1008,8 @@ void VulkanEngine::initBackgroundPipelines() {
 void VulkanEngine::initTrianglePipeline() {
     VkShaderModule triangleVertShader{VK_NULL_HANDLE};
     VkShaderModule triangleFragShader{VK_NULL_HANDLE};
-    assert(vkutils::LoadShaderModule(m_Device, "Assets/Shaders/ColoredTriangle.vert.spv", &triangleVertShader));
-    assert(vkutils::LoadShaderModule(m_Device, "Assets/Shaders/ColoredTriangle.frag.spv", &triangleFragShader));
+    assert(m_ShaderModuleCache.getShaderModule("Assets/Shaders/ColoredTriangle.vert.spv", &triangleVertShader));
+    assert(m_ShaderModuleCache.getShaderModule("Assets/Shaders/ColoredTriangle.frag.spv", &triangleFragShader));
 
     VkPipelineLayoutCreateInfo pipelineLayoutInfo = vkinit::GetPipelineLayoutInfo();
     VK_CHECK(vkCreatePipelineLayout(m_Device, &pipelineLayoutInfo, nullptr, &m_TrianglePipelineLayout));
@@ -576,15 +1023,23 @@ void VulkanEngine::initTrianglePipeline() {
     pipelineBuilder.setBlendingDisabled();
     pipelineBuilder.setDepthTestDisabled();
     pipelineBuilder.setColorAttachmentFormat(m_DrawImage.Format);
-    pipelineBuilder.setDepthFormat(m_DepthImage.Format);
-
-    m_TrianglePipeline = pipelineBuilder.build(m_Device, m_TrianglePipelineLayout);
-
-    vkDestroyShaderModule(m_Device, triangleVertShader, nullptr);
-    vkDestroyShaderModule(m_Device, triangleFragShader, nullptr);
+    pipelineBuilder.setDepthFormat(m_DepthFormat);
+    pipelineBuilder.setDynamicState(m_DynamicStateTracker.getSupportedFlags());
+    m_TriangleDynamicState = pipelineBuilder.getDynamicState();
+
+    m_PipelineVariants.getPipeline(pipelineBuilder, m_TrianglePipelineLayout, &m_TrianglePipeline);
+
+    registerReloadablePipeline(ReloadablePipeline{
+        .ShaderPaths = {"Assets/Shaders/ColoredTriangle.vert.spv", "Assets/Shaders/ColoredTriangle.frag.spv"},
+        .Build = [this, pipelineBuilder](std::span<const VkShaderModule> shaderModules) {
+            PipelineBuilder builder{pipelineBuilder};
+            builder.setShaders(shaderModules[0], shaderModules[1]);
+            return builder.build(m_Device, m_TrianglePipelineLayout, m_PipelineCache.get());
+        },
+        .Target = &m_TrianglePipeline,
+    });
 
     m_MainDeletionQueue.pushFunction([this]() {
-        vkDestroyPipeline(m_Device, m_TrianglePipeline, nullptr);
         vkDestroyPipelineLayout(m_Device, m_TrianglePipelineLayout, nullptr);
     });
 }
@@ -592,8 +1047,8 @@ void VulkanEngine::initTrianglePipeline() {
 void VulkanEngine::initMeshPipeline() {
     VkShaderModule triangleVertShader{VK_NULL_HANDLE};
     VkShaderModule triangleFragShader{VK_NULL_HANDLE};
-    assert(vkutils::LoadShaderModule(m_Device, "Assets/Shaders/ColoredTriangleMesh.vert.spv", &triangleVertShader));
-    assert(vkutils::LoadShaderModule(m_Device, "Assets/Shaders/ColoredTriangle.frag.spv", &triangleFragShader));
+    assert(m_ShaderModuleCache.getShaderModule("Assets/Shaders/ColoredTriangleMesh.vert.spv", &triangleVertShader));
+    assert(m_ShaderModuleCache.getShaderModule("Assets/Shaders/ColoredTriangleMesh.frag.spv", &triangleFragShader));
 
     VkPushConstantRange bufferRange{
         .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
@@ -601,7 +1056,11 @@ void VulkanEngine::initMeshPipeline() {
         .size = sizeof(GPUDrawPushConstants),
     };
 
+    std::array<VkDescriptorSetLayout, 2> setLayouts{m_BindlessHeap.getLayout(), m_SceneDataDescriptorLayout};
+
     VkPipelineLayoutCreateInfo pipelineLayoutInfo = vkinit::GetPipelineLayoutInfo();
+    pipelineLayoutInfo.setLayoutCount = (std::uint32_t)setLayouts.size();
+    pipelineLayoutInfo.pSetLayouts = setLayouts.data();
     pipelineLayoutInfo.pushConstantRangeCount = 1;
     pipelineLayoutInfo.pPushConstantRanges = &bufferRange;
     VK_CHECK(vkCreatePipelineLayout(m_Device, &pipelineLayoutInfo, nullptr, &m_MeshPipelineLayout));
@@ -615,15 +1074,23 @@ void VulkanEngine::initMeshPipeline() {
     pipelineBuilder.setBlendingAdditiveEnabled();
     pipelineBuilder.setDepthTestEnabled(true, VK_COMPARE_OP_GREATER_OR_EQUAL);
     pipelineBuilder.setColorAttachmentFormat(m_DrawImage.Format);
-    pipelineBuilder.setDepthFormat(m_DepthImage.Format);
-
-    m_MeshPipeline = pipelineBuilder.build(m_Device, m_MeshPipelineLayout);
-
-    vkDestroyShaderModule(m_Device, triangleVertShader, nullptr);
-    vkDestroyShaderModule(m_Device, triangleFragShader, nullptr);
+    pipelineBuilder.setDepthFormat(m_DepthFormat);
+    pipelineBuilder.setDynamicState(m_DynamicStateTracker.getSupportedFlags());
+    m_MeshDynamicState = pipelineBuilder.getDynamicState();
+
+    m_PipelineVariants.getPipeline(pipelineBuilder, m_MeshPipelineLayout, &m_MeshPipeline);
+
+    registerReloadablePipeline(ReloadablePipeline{
+        .ShaderPaths = {"Assets/Shaders/ColoredTriangleMesh.vert.spv", "Assets/Shaders/ColoredTriangleMesh.frag.spv"},
+        .Build = [this, pipelineBuilder](std::span<const VkShaderModule> shaderModules) {
+            PipelineBuilder builder{pipelineBuilder};
+            builder.setShaders(shaderModules[0], shaderModules[1]);
+            return builder.build(m_Device, m_MeshPipelineLayout, m_PipelineCache.get());
+        },
+        .Target = &m_MeshPipeline,
+    });
 
     m_MainDeletionQueue.pushFunction([this]() {
-        vkDestroyPipeline(m_Device, m_MeshPipeline, nullptr);
         vkDestroyPipelineLayout(m_Device, m_MeshPipelineLayout, nullptr);
     });
 }
@@ -695,19 +1162,162 @@ void VulkanEngine::initDefaultData() {
 
     m_Rectangle = createMesh(rectIndices, rectVertices);
 
-    m_TestMeshes = loadGltfMeshes(this, "Assets/Models/basicmesh.glb").value();
+    m_SamplerCache.init(m_Device, &m_BindlessHeap);
+    m_DefaultSamplerLinear = m_SamplerCache.getSampler(SamplerKey{});
+    m_DefaultSamplerIndex = m_SamplerCache.getBindlessIndex(SamplerKey{});
+    m_DefaultSamplerNearest = m_SamplerCache.getSampler(SamplerKey{
+        .MagFilter = VK_FILTER_NEAREST,
+        .MinFilter = VK_FILTER_NEAREST,
+        .MipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST,
+    });
+
+    const std::uint32_t white = 0xFFFFFFFF;
+    m_WhiteImage = createImage(&white, VkExtent3D{1, 1, 1}, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_SAMPLED_BIT);
+    m_WhiteImageIndex = m_BindlessHeap.addSampledImage(m_ResourcePools.getImage(m_WhiteImage)->View);
+
+    const std::uint32_t black = 0xFF000000;
+    const std::uint32_t magenta = 0xFFFF00FF;
+    std::array<std::uint32_t, 16 * 16> checkerboard{};
+    for (std::uint32_t y = 0; y < 16; y++) {
+        for (std::uint32_t x = 0; x < 16; x++) {
+            checkerboard[y * 16 + x] = ((x % 2) ^ (y % 2)) ? magenta : black;
+        }
+    }
+    m_ErrorCheckerboardImage = createImage(checkerboard.data(), VkExtent3D{16, 16, 1}, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_SAMPLED_BIT);
+
+    m_TextureStreamer.init(m_Device, m_Allocator, &m_BindlessHeap, &m_MemoryTelemetry, &m_ResourcePools, &m_DeferredDeletionQueue);
+
+    m_Scene = std::move(loadGltfScene(this, "Assets/Models/basicmesh.glb").value());
 
     m_MainDeletionQueue.pushFunction([this]() {
-        destroyBuffer(m_Rectangle.IndexBuffer);
-        destroyBuffer(m_Rectangle.VertexBuffer);
+        unloadScene(m_Scene);
+        m_TextureStreamer.destroy();
+        if (m_WhiteImageIndex != BINDLESS_INVALID_INDEX) m_BindlessHeap.removeSampledImage(m_WhiteImageIndex);
+        m_SamplerCache.destroy();
+    });
+}
+
+void VulkanEngine::unloadScene(LoadedScene &scene) {
+    for (const std::shared_ptr<MeshAsset> &mesh : scene.Meshes) {
+        m_ResourcePools.releaseMesh(mesh->Mesh, (std::uint64_t)m_FrameNumber);
+    }
+
+    for (std::uint32_t texture : scene.Textures) {
+        if (texture != STREAMING_INVALID_TEXTURE) m_TextureStreamer.removeTexture(texture);
+    }
+
+    scene.Graph.clear();
+    scene.Meshes.clear();
+    scene.Textures.clear();
+}
+
+void VulkanEngine::initSimulation() {
+    m_Simulation.init(&m_Scene.Graph, &m_JobSystem);
+    m_Simulation.start();
+}
+
+void VulkanEngine::initShaderHotReload() {
+    m_ShaderWatcher.init();
+    m_ShaderWatcher.addDirectory("Assets/Shaders");
+#if defined(VKGUIDE_SHADER_SOURCE_DIR)
+    m_ShaderWatcher.addDirectory(VKGUIDE_SHADER_SOURCE_DIR);
+#endif
+}
+
+void VulkanEngine::registerReloadablePipeline(ReloadablePipeline &&reloadable) {
+    m_ReloadablePipelines.emplace_back(std::move(reloadable));
+}
+
+void VulkanEngine::pollShaderChanges() {
+    for (const std::filesystem::path &path : m_ShaderWatcher.pollChanges()) {
+        const std::filesystem::path extension = path.extension();
+
+        if (extension == ".spv") {
+            for (std::uint32_t i = 0; i < m_ReloadablePipelines.size(); i++) {
+                const std::vector<std::string> &shaderPaths = m_ReloadablePipelines[i].ShaderPaths;
+                if (std::find(shaderPaths.begin(), shaderPaths.end(), path.generic_string()) != shaderPaths.end()) {
+                    reloadPipeline(i);
+                }
+            }
+        } else if (extension == ".vert" || extension == ".frag" || extension == ".comp") {
+            recompileShader(path);
+        } else if (extension == ".glsl") {
+            std::error_code error{};
+            for (const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator{path.parent_path(), error}) {
+                const std::filesystem::path entryExtension = entry.path().extension();
+                if (entryExtension == ".vert" || entryExtension == ".frag" || entryExtension == ".comp") {
+                    recompileShader(entry.path());
+                }
+            }
+        }
+    }
+}
+
+void VulkanEngine::recompileShader(const std::filesystem::path &sourcePath) {
+    m_JobSystem.submit([sourcePath]() {
+        const std::filesystem::path outputPath = std::filesystem::path{"Assets/Shaders"} / (sourcePath.filename().string() + ".spv");
+        const std::string command = fmt::format("glslangValidator -V \"{}\" -o \"{}\" --target-env vulkan1.3", sourcePath.string(), outputPath.string());
+
+        fmt::println("[INFO]: Recompiling shader: {}.", sourcePath.string());
+        if (std::system(command.c_str()) != 0) {
+            fmt::println("[ERROR]: Failed to recompile shader: {}.", sourcePath.string());
+        }
+    });
+}
+
+void VulkanEngine::reloadPipeline(std::uint32_t index) {
+    m_JobSystem.submit([this, reloadable = m_ReloadablePipelines[index]]() {
+        std::vector<VkShaderModule> shaderModules(reloadable.ShaderPaths.size(), VK_NULL_HANDLE);
+
+        bool loaded{true};
+        for (std::uint32_t i = 0; i < reloadable.ShaderPaths.size(); i++) {
+            loaded = loaded && vkutils::LoadShaderModule(m_Device, reloadable.ShaderPaths[i].c_str(), &shaderModules[i]);
+        }
+
+        VkPipeline pipeline = loaded ? reloadable.Build(shaderModules) : VK_NULL_HANDLE;
 
-        for (const std::shared_ptr<MeshAsset> &mesh : m_TestMeshes) {
-            destroyBuffer(mesh->MeshBuffers.IndexBuffer);
-            destroyBuffer(mesh->MeshBuffers.VertexBuffer);
+        for (VkShaderModule shaderModule : shaderModules) {
+            if (shaderModule != VK_NULL_HANDLE) vkDestroyShaderModule(m_Device, shaderModule, nullptr);
         }
+
+        if (pipeline == VK_NULL_HANDLE) {
+            fmt::println("[ERROR]: Failed to reload pipeline for shader: {}.", reloadable.ShaderPaths[0]);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock{m_ReloadMutex};
+        m_ReloadedPipelines.emplace_back(reloadable.Target, pipeline);
+        fmt::println("[INFO]: Reloaded pipeline for shader: {}.", reloadable.ShaderPaths[0]);
     });
 }
 
+void VulkanEngine::applyReloadedPipelines() {
+    std::lock_guard<std::mutex> lock{m_ReloadMutex};
+
+    for (const auto &[target, pipeline] : m_ReloadedPipelines) {
+        VkPipeline retired = *target;
+        *target = pipeline;
+        for (ReloadablePipeline &reloadable : m_ReloadablePipelines) {
+            if (*reloadable.Target == retired) *reloadable.Target = pipeline;
+        }
+        m_PipelineVariants.replace(retired, pipeline);
+        m_RenderList.replacePipeline(retired, pipeline);
+
+        m_DeferredDeletionQueue.pushPipeline(retired, (std::uint64_t)m_FrameNumber);
+    }
+
+    m_ReloadedPipelines.clear();
+
+    for (const auto &[linked, optimized] : m_PipelineVariants.applyOptimizedPipelines()) {
+        for (ReloadablePipeline &reloadable : m_ReloadablePipelines) {
+            if (*reloadable.Target == linked) *reloadable.Target = optimized;
+        }
+        m_RenderList.replacePipeline(linked, optimized);
+
+        m_DeferredDeletionQueue.pushPipeline(linked, (std::uint64_t)m_FrameNumber);
+    }
+}
+
 void VulkanEngine::createSwapchain(std::uint32_t width, std::uint32_t height) {
     if (m_Swapchain != VK_NULL_HANDLE) {
         destroySwapchain();
@@ -763,7 +1373,7 @@ FrameData &VulkanEngine::getCurrentFrame() {
     return m_Frames[m_FrameNumber % FRAME_OVERLAP];
 }
 
-AllocatedBuffer VulkanEngine::createBuffer(std::size_t allocationSize, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage) {
+AllocatedBuffer VulkanEngine::createBuffer(std::size_t allocationSize, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage, MemoryCategory category, VmaAllocationCreateFlags flags) {
     VkBufferCreateInfo bufferInfo{
         .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
         .size = allocationSize,
@@ -771,51 +1381,338 @@ AllocatedBuffer VulkanEngine::createBuffer(std::size_t allocationSize, VkBufferU
     };
 
     VmaAllocationCreateInfo vmaAllocationInfo{
-        .flags = VMA_ALLOCATION_CREATE_MAPPED_BIT,
+        .flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | flags,
         .usage = memoryUsage,
     };
 
     AllocatedBuffer buffer{};
     VK_CHECK(vmaCreateBuffer(m_Allocator, &bufferInfo, &vmaAllocationInfo, &buffer.Buffer, &buffer.Allocation, &buffer.Info));
+    m_MemoryTelemetry.track(buffer.Allocation, category);
     return buffer;
 }
 
-GPUMeshBuffers VulkanEngine::createMesh(const std::span<std::uint32_t> &indices, const std::span<Vertex> &vertices) {
+MeshHandle VulkanEngine::createMesh(const std::span<std::uint32_t> &indices, const std::span<Vertex> &vertices) {
     const std::size_t vertexBufferSize = vertices.size() * sizeof(Vertex);
     const std::size_t indexBufferSize = indices.size() * sizeof(std::uint32_t);
 
+    constexpr VmaAllocationCreateFlags uploadFlags{VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT};
+
     GPUMeshBuffers surface{};
-    surface.VertexBuffer = createBuffer(vertexBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+    surface.VertexBuffer = createBuffer(vertexBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT, VMA_MEMORY_USAGE_AUTO, MemoryCategory::Mesh, uploadFlags);
     VkBufferDeviceAddressInfo deviceAddressInfo{
         .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
         .buffer = surface.VertexBuffer.Buffer,
     };
     surface.VertexBufferAddress = vkGetBufferDeviceAddress(m_Device, &deviceAddressInfo);
-    surface.IndexBuffer = createBuffer(indexBufferSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+    surface.IndexBuffer = createBuffer(indexBufferSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_AUTO, MemoryCategory::Mesh, uploadFlags);
+
+    const bool isVertexDirect = writeMappedBuffer(surface.VertexBuffer, vertices.data(), vertexBufferSize);
+    const bool isIndexDirect = writeMappedBuffer(surface.IndexBuffer, indices.data(), indexBufferSize);
+
+    const std::size_t stagedVertexSize = isVertexDirect ? 0 : vertexBufferSize;
+    const std::size_t stagedIndexSize = isIndexDirect ? 0 : indexBufferSize;
+
+    m_MeshUploadStats.DirectBufferCount += (isVertexDirect ? 1 : 0) + (isIndexDirect ? 1 : 0);
+    m_MeshUploadStats.StagedBufferCount += (isVertexDirect ? 0 : 1) + (isIndexDirect ? 0 : 1);
+    m_MeshUploadStats.DirectBytes += (vertexBufferSize - stagedVertexSize) + (indexBufferSize - stagedIndexSize);
+    m_MeshUploadStats.StagedBytes += stagedVertexSize + stagedIndexSize;
 
-    AllocatedBuffer staging = createBuffer(vertexBufferSize + indexBufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
+    if (stagedVertexSize + stagedIndexSize == 0) return m_ResourcePools.addMesh(surface);
+
+    AllocatedBuffer staging = createBuffer(stagedVertexSize + stagedIndexSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY, MemoryCategory::Staging);
 
     void *data = staging.Allocation->GetMappedData();
-    memcpy(data, vertices.data(), vertexBufferSize);
-    memcpy((char *)data + vertexBufferSize, indices.data(), indexBufferSize);
+    memcpy(data, vertices.data(), stagedVertexSize);
+    memcpy((char *)data + stagedVertexSize, indices.data(), stagedIndexSize);
 
     immediateSubmit([&](VkCommandBuffer commandBuffer) {
-        VkBufferCopy vertexCopy{
-            .srcOffset = 0,
-            .dstOffset = 0,
-            .size = vertexBufferSize,
-        };
-        VkBufferCopy indexCopy{
-            .srcOffset = vertexBufferSize,
-            .dstOffset = 0,
-            .size = indexBufferSize,
-        };
+        if (stagedVertexSize > 0) {
+            VkBufferCopy vertexCopy{
+                .srcOffset = 0,
+                .dstOffset = 0,
+                .size = stagedVertexSize,
+            };
+            vkCmdCopyBuffer(commandBuffer, staging.Buffer, surface.VertexBuffer.Buffer, 1, &vertexCopy);
+        }
+        if (stagedIndexSize > 0) {
+            VkBufferCopy indexCopy{
+                .srcOffset = stagedVertexSize,
+                .dstOffset = 0,
+                .size = stagedIndexSize,
+            };
+            vkCmdCopyBuffer(commandBuffer, staging.Buffer, surface.IndexBuffer.Buffer, 1, &indexCopy);
+        }
+    });
+
+    destroyBuffer(staging);
+
+    return m_ResourcePools.addMesh(surface);
+}
+
+bool VulkanEngine::writeMappedBuffer(const AllocatedBuffer &buffer, const void *data, std::size_t size) {
+    VkMemoryPropertyFlags memoryProperties = 0;
+    vmaGetAllocationMemoryProperties(m_Allocator, buffer.Allocation, &memoryProperties);
+    if ((memoryProperties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) == 0 || buffer.Info.pMappedData == nullptr) return false;
+
+    memcpy(buffer.Info.pMappedData, data, size);
+    VK_CHECK(vmaFlushAllocation(m_Allocator, buffer.Allocation, 0, size));
+    return true;
+}
 
-        vkCmdCopyBuffer(commandBuffer, staging.Buffer, surface.VertexBuffer.Buffer, 1, &vertexCopy);
-        vkCmdCopyBuffer(commandBuffer, staging.Buffer, surface.IndexBuffer.Buffer, 1, &indexCopy);
+ImageHandle VulkanEngine::createImage(VkExtent3D extent, VkFormat format, VkImageUsageFlags usage, bool mipmapped) {
+    return m_ResourcePools.addImage(allocateImage(extent, format, usage, mipmapped ? vkutils::GetMipLevelCount(VkExtent2D{extent.width, extent.height}) : 1));
+}
+
+AllocatedImage VulkanEngine::allocateImage(VkExtent3D extent, VkFormat format, VkImageUsageFlags usage, std::uint32_t mipLevels) {
+    AllocatedImage image{
+        .Extent = extent,
+        .Format = format,
+        .MipLevels = mipLevels,
+    };
+
+    VkImageCreateInfo imageInfo = vkinit::GetImageCreateInfo(format, usage, extent, image.MipLevels);
+
+    VmaAllocationCreateInfo allocationInfo{
+        .usage = VMA_MEMORY_USAGE_GPU_ONLY,
+        .requiredFlags = VkMemoryPropertyFlags(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+    };
+    VK_CHECK(vmaCreateImage(m_Allocator, &imageInfo, &allocationInfo, &image.Image, &image.Allocation, nullptr));
+    m_MemoryTelemetry.track(image.Allocation, MemoryCategory::Texture);
+
+    VkImageAspectFlags aspectMask = (format == VK_FORMAT_D32_SFLOAT) ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+    VkImageViewCreateInfo viewInfo = vkinit::GetImageViewCreateInfo(format, image.Image, aspectMask, image.MipLevels);
+    VK_CHECK(vkCreateImageView(m_Device, &viewInfo, nullptr, &image.View));
+
+    return image;
+}
+
+ImageHandle VulkanEngine::createImage(const void *data, VkExtent3D extent, VkFormat format, VkImageUsageFlags usage, bool mipmapped) {
+    const std::uint8_t *bytes = (const std::uint8_t *)data;
+
+    std::array<std::optional<DecodedTexture>, 1> textures{
+        DecodedTexture{
+            .Pixels = std::vector<std::uint8_t>(bytes, bytes + (std::size_t)extent.width * extent.height * 4),
+            .Extent = VkExtent2D{extent.width, extent.height},
+            .Format = format,
+        },
+    };
+
+    return m_ResourcePools.addImage(uploadTextures(textures, usage, mipmapped)[0]);
+}
+
+std::vector<ImageHandle> VulkanEngine::createTextures(std::span<const TextureSource> sources) {
+    std::vector<std::optional<DecodedTexture>> textures = loadTextures(sources, false);
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    std::vector<AllocatedImage> images = uploadTextures(textures, VK_IMAGE_USAGE_SAMPLED_BIT, true);
+    std::chrono::duration<double, std::milli> uploadTime = std::chrono::high_resolution_clock::now() - start;
+
+    std::uint64_t uploadedBytes = 0;
+    for (const std::optional<DecodedTexture> &texture : textures) {
+        if (texture.has_value()) uploadedBytes += texture->Pixels.size();
+    }
+
+    m_TextureStats.UploadedBytes += uploadedBytes;
+    m_TextureStats.UploadTime += uploadTime.count();
+
+    const double uploadedMegabytes = (double)uploadedBytes / (1024.0 * 1024.0);
+    fmt::println("[INFO]: Uploaded {:.2f} MB of textures in {:.2f} ms ({:.1f} MB/s).",
+                 uploadedMegabytes,
+                 uploadTime.count(),
+                 uploadedMegabytes / std::max(uploadTime.count() / 1000.0, 1e-6));
+
+    std::vector<ImageHandle> handles(images.size());
+    for (std::size_t i = 0; i < images.size(); i++) {
+        if (images[i].Image != VK_NULL_HANDLE) handles[i] = m_ResourcePools.addImage(images[i]);
+    }
+
+    return handles;
+}
+
+std::vector<std::uint32_t> VulkanEngine::createStreamedTextures(std::span<const TextureSource> sources) {
+    std::vector<std::optional<DecodedTexture>> textures = loadTextures(sources, true);
+
+    std::vector<std::uint32_t> streamedTextures(textures.size(), STREAMING_INVALID_TEXTURE);
+    for (std::size_t i = 0; i < textures.size(); i++) {
+        if (textures[i].has_value()) streamedTextures[i] = m_TextureStreamer.addTexture(std::move(textures[i].value()));
+    }
+
+    return streamedTextures;
+}
+
+std::vector<std::optional<DecodedTexture>> VulkanEngine::loadTextures(std::span<const TextureSource> sources, bool buildMipChain) {
+    std::vector<std::optional<DecodedTexture>> textures(sources.size());
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    m_JobSystem.parallelFor((std::uint32_t)sources.size(), 1, [&](std::uint32_t begin, std::uint32_t end) {
+        for (std::uint32_t i = begin; i < end; i++) {
+            textures[i] = vkutils::LoadTexture(sources[i], m_CompressedFormatSupport);
+            if (buildMipChain && textures[i].has_value() && textures[i]->Levels.empty()) {
+                textures[i] = vkutils::GenerateMipChain(textures[i].value());
+            }
+        }
     });
+    std::chrono::duration<double, std::milli> decodeTime = std::chrono::high_resolution_clock::now() - start;
+
+    std::uint64_t encodedBytes = 0;
+    std::uint32_t failedCount = 0;
+    std::uint32_t compressedCount = 0;
+    std::uint32_t cachedCount = 0;
+    for (std::size_t i = 0; i < sources.size(); i++) {
+        if (!textures[i].has_value()) {
+            failedCount++;
+            continue;
+        }
+
+        if (!sources[i].Bytes.empty()) {
+            encodedBytes += sources[i].Bytes.size();
+        } else {
+            // The file may have been removed since it was decoded, leave it out of the byte count.
+            std::error_code error{};
+            const std::uintmax_t fileSize = std::filesystem::file_size(sources[i].FilePath, error);
+            if (!error) encodedBytes += fileSize;
+        }
+        compressedCount += vkutils::IsBlockCompressed(textures[i]->Format) ? 1 : 0;
+        cachedCount += textures[i]->IsCached ? 1 : 0;
+    }
+
+    m_TextureStats.TextureCount += (std::uint32_t)sources.size() - failedCount;
+    m_TextureStats.FailedCount += failedCount;
+    m_TextureStats.CompressedCount += compressedCount;
+    m_TextureStats.CachedCount += cachedCount;
+    m_TextureStats.EncodedBytes += encodedBytes;
+    m_TextureStats.DecodeTime += decodeTime.count();
+
+    const double encodedMegabytes = (double)encodedBytes / (1024.0 * 1024.0);
+    fmt::println("[INFO]: Loaded {} textures ({} compressed, {} cached, {:.2f} MB source) in {:.2f} ms ({:.1f} MB/s) on {} threads.",
+                 sources.size() - failedCount,
+                 compressedCount,
+                 cachedCount,
+                 encodedMegabytes,
+                 decodeTime.count(),
+                 encodedMegabytes / std::max(decodeTime.count() / 1000.0, 1e-6),
+                 m_JobSystem.getWorkerCount() + 1);
+
+    return textures;
+}
+
+std::vector<AllocatedImage> VulkanEngine::uploadTextures(std::span<const std::optional<DecodedTexture>> textures, VkImageUsageFlags usage, bool mipmapped) {
+    std::vector<AllocatedImage> images(textures.size());
+
+    auto alignOffset = [](std::size_t offset) {
+        return (offset + TEXTURE_STAGING_ALIGNMENT - 1) & ~(TEXTURE_STAGING_ALIGNMENT - 1);
+    };
+
+    std::size_t totalSize = 0;
+    std::size_t largestSize = 0;
+    for (std::size_t i = 0; i < textures.size(); i++) {
+        if (!textures[i].has_value()) continue;
+
+        const DecodedTexture &texture = textures[i].value();
+        const VkExtent3D extent{texture.Extent.width, texture.Extent.height, 1};
+
+        if (!texture.Levels.empty()) {
+            images[i] = allocateImage(extent, texture.Format, usage | VK_IMAGE_USAGE_TRANSFER_DST_BIT, (std::uint32_t)texture.Levels.size());
+        } else {
+            VkFormatProperties formatProperties{};
+            vkGetPhysicalDeviceFormatProperties(m_PhysicalDevice, texture.Format, &formatProperties);
+
+            const VkFormatFeatureFlags blitFeatures = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+            const bool canBlit = (formatProperties.optimalTilingFeatures & blitFeatures) == blitFeatures;
+
+            const std::uint32_t mipLevels = (mipmapped && canBlit) ? vkutils::GetMipLevelCount(texture.Extent) : 1;
+            images[i] = allocateImage(extent, texture.Format, usage | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, mipLevels);
+        }
+
+        totalSize += alignOffset(texture.Pixels.size());
+        largestSize = std::max(largestSize, texture.Pixels.size());
+    }
+
+    if (totalSize == 0) return images;
+
+    const std::size_t stagingSize = std::min(totalSize, std::max(TEXTURE_STAGING_BUDGET, largestSize));
+    AllocatedBuffer staging = createBuffer(stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY, MemoryCategory::Staging);
+    void *data = staging.Allocation->GetMappedData();
+
+    std::size_t first = 0;
+    while (first < textures.size()) {
+        std::vector<std::pair<std::size_t, VkDeviceSize>> batch{};
+
+        std::size_t offset = 0;
+        std::size_t last = first;
+        for (; last < textures.size(); last++) {
+            if (!textures[last].has_value()) continue;
+
+            const std::vector<std::uint8_t> &pixels = textures[last]->Pixels;
+            if (offset + pixels.size() > stagingSize) break;
+
+            memcpy((char *)data + offset, pixels.data(), pixels.size());
+            batch.emplace_back(last, offset);
+            offset = alignOffset(offset + pixels.size());
+        }
+
+        first = last;
+        if (batch.empty()) continue;
+
+        immediateSubmit([&](VkCommandBuffer commandBuffer) {
+            BarrierBuilder barriers{};
+            for (const auto &[index, bufferOffset] : batch) {
+                const AllocatedImage &image = images[index];
+                barriers.trackImage(image.Image, VK_IMAGE_ASPECT_COLOR_BIT, image.MipLevels);
+                barriers.transitionImage(image.Image, BARRIER_SCOPE_NONE, BARRIER_SCOPE_TRANSFER_WRITE, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+            }
+            barriers.flush(commandBuffer);
+
+            std::vector<TextureLevel> levels{};
+            std::vector<VkBufferImageCopy> copyRegions{};
+
+            for (const auto &[index, bufferOffset] : batch) {
+                const DecodedTexture &texture = textures[index].value();
+                const AllocatedImage &image = images[index];
+
+                copyRegions.clear();
+                if (texture.Levels.empty()) {
+                    levels.assign(1, TextureLevel{.Offset = 0, .Size = texture.Pixels.size(), .Extent = texture.Extent});
+                } else {
+                    levels.assign(texture.Levels.begin(), texture.Levels.end());
+                }
+
+                for (std::uint32_t level = 0; level < levels.size(); level++) {
+                    copyRegions.emplace_back(VkBufferImageCopy{
+                        .bufferOffset = bufferOffset + levels[level].Offset,
+                        .bufferRowLength = 0,
+                        .bufferImageHeight = 0,
+                        .imageSubresource = VkImageSubresourceLayers{
+                            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                            .mipLevel = level,
+                            .baseArrayLayer = 0,
+                            .layerCount = 1,
+                        },
+                        .imageExtent = VkExtent3D{levels[level].Extent.width, levels[level].Extent.height, 1},
+                    });
+                }
+                vkCmdCopyBufferToImage(commandBuffer, staging.Buffer, image.Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, (std::uint32_t)copyRegions.size(), copyRegions.data());
+            }
+
+            for (const auto &[index, bufferOffset] : batch) {
+                const AllocatedImage &image = images[index];
+                if (textures[index]->Levels.empty() && image.MipLevels > 1) {
+                    vkutils::GenerateMipmaps(commandBuffer, barriers, image.Image, VkExtent2D{image.Extent.width, image.Extent.height}, image.MipLevels);
+                }
+            }
+
+            for (const auto &[index, bufferOffset] : batch) {
+                barriers.transitionImage(images[index].Image, BARRIER_SCOPE_TRANSFER_WRITE, BARRIER_SCOPE_SHADER_SAMPLED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+            }
+            barriers.flush(commandBuffer);
+        });
+    }
 
     destroyBuffer(staging);
 
-    return surface;
-}
\ No newline at end of file
+    return images;
+}
+
+std::uint32_t VulkanEngine::getSamplerIndex(const SamplerKey &key) {
+    return m_SamplerCache.getBindlessIndex(key);
+}
@@ -0,0 +1,113 @@
+#include <VkGuide/VkBarriers.hpp>
+
+#include <algorithm>
+
+BarrierBuilder::BarrierBuilder(std::pmr::memory_resource *memory) : m_Images{memory}, m_ImageBarriers{memory}, m_BufferBarriers{memory} {
+}
+
+void BarrierBuilder::trackImage(VkImage image, VkImageAspectFlags aspect, std::uint32_t mipLevels, VkImageLayout layout) {
+    m_Images.insert_or_assign(image, TrackedImage{
+        .Aspect = aspect,
+        .Layouts = std::pmr::vector<VkImageLayout>(mipLevels, layout, m_Images.get_allocator()),
+    });
+}
+
+void BarrierBuilder::untrackImage(VkImage image) {
+    m_Images.erase(image);
+}
+
+VkImageLayout BarrierBuilder::getLayout(VkImage image, std::uint32_t mipLevel) const {
+    const auto it = m_Images.find(image);
+    assert(it != m_Images.end() && mipLevel < it->second.Layouts.size());
+    return it->second.Layouts[mipLevel];
+}
+
+BarrierBuilder &BarrierBuilder::transitionImage(VkImage image, const BarrierScope &src, const BarrierScope &dst, VkImageLayout newLayout) {
+    const auto it = m_Images.find(image);
+    assert(it != m_Images.end());
+    return transitionImageMips(image, 0, (std::uint32_t)it->second.Layouts.size(), src, dst, newLayout);
+}
+
+BarrierBuilder &BarrierBuilder::transitionImageMips(VkImage image, std::uint32_t baseMipLevel, std::uint32_t mipCount, const BarrierScope &src, const BarrierScope &dst, VkImageLayout newLayout) {
+    const auto it = m_Images.find(image);
+    assert(it != m_Images.end() && baseMipLevel + mipCount <= it->second.Layouts.size());
+
+    TrackedImage &tracked = it->second;
+    std::uint32_t first = baseMipLevel;
+    while (first < baseMipLevel + mipCount) {
+        const VkImageLayout oldLayout = tracked.Layouts[first];
+
+        std::uint32_t last = first + 1;
+        while (last < baseMipLevel + mipCount && tracked.Layouts[last] == oldLayout) last++;
+
+        m_ImageBarriers.emplace_back(VkImageMemoryBarrier2{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+
+            .srcStageMask = src.Stage,
+            .srcAccessMask = src.Access,
+            .dstStageMask = dst.Stage,
+            .dstAccessMask = dst.Access,
+
+            .oldLayout = oldLayout,
+            .newLayout = newLayout,
+
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+
+            .image = image,
+            .subresourceRange = VkImageSubresourceRange{
+                .aspectMask = tracked.Aspect,
+                .baseMipLevel = first,
+                .levelCount = last - first,
+                .baseArrayLayer = 0,
+                .layerCount = VK_REMAINING_ARRAY_LAYERS,
+            },
+        });
+
+        std::fill(tracked.Layouts.begin() + first, tracked.Layouts.begin() + last, newLayout);
+        first = last;
+    }
+
+    return *this;
+}
+
+BarrierBuilder &BarrierBuilder::bufferBarrier(VkBuffer buffer, const BarrierScope &src, const BarrierScope &dst, VkDeviceSize offset, VkDeviceSize size) {
+    m_BufferBarriers.emplace_back(VkBufferMemoryBarrier2{
+        .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+
+        .srcStageMask = src.Stage,
+        .srcAccessMask = src.Access,
+        .dstStageMask = dst.Stage,
+        .dstAccessMask = dst.Access,
+
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+
+        .buffer = buffer,
+        .offset = offset,
+        .size = size,
+    });
+
+    return *this;
+}
+
+void BarrierBuilder::flush(VkCommandBuffer commandBuffer) {
+    if (m_ImageBarriers.empty() && m_BufferBarriers.empty()) return;
+
+    VkDependencyInfo dependencyInfo{
+        .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+        .bufferMemoryBarrierCount = (std::uint32_t)m_BufferBarriers.size(),
+        .pBufferMemoryBarriers = m_BufferBarriers.data(),
+        .imageMemoryBarrierCount = (std::uint32_t)m_ImageBarriers.size(),
+        .pImageMemoryBarriers = m_ImageBarriers.data(),
+    };
+
+    vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+    m_ImageBarriers.clear();
+    m_BufferBarriers.clear();
+}
+
+std::uint32_t BarrierBuilder::getPendingCount() const {
+    return (std::uint32_t)(m_ImageBarriers.size() + m_BufferBarriers.size());
+}
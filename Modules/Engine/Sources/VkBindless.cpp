@@ -0,0 +1,212 @@
+#include <VkGuide/VkBindless.hpp>
+
+#include <algorithm>
+
+void BindlessIndexAllocator::init(std::uint32_t capacity) {
+    m_Capacity = capacity;
+    m_NextIndex = 0;
+    m_FreeIndices.clear();
+    m_RetiredIndices.clear();
+}
+
+std::uint32_t BindlessIndexAllocator::allocate() {
+    if (!m_FreeIndices.empty()) {
+        std::uint32_t index = m_FreeIndices.back();
+        m_FreeIndices.pop_back();
+        return index;
+    }
+
+    if (m_NextIndex == m_Capacity) return BINDLESS_INVALID_INDEX;
+    return m_NextIndex++;
+}
+
+void BindlessIndexAllocator::release(std::uint32_t index, std::uint64_t frameNumber) {
+    assert(index < m_NextIndex);
+    m_RetiredIndices.emplace_back(RetiredIndex{.Index = index, .FrameNumber = frameNumber});
+}
+
+void BindlessIndexAllocator::recycle(std::uint64_t completedFrameNumber) {
+    while (!m_RetiredIndices.empty() && m_RetiredIndices.front().FrameNumber <= completedFrameNumber) {
+        m_FreeIndices.emplace_back(m_RetiredIndices.front().Index);
+        m_RetiredIndices.pop_front();
+    }
+}
+
+std::uint32_t BindlessIndexAllocator::getCapacity() const {
+    return m_Capacity;
+}
+
+std::uint32_t BindlessIndexAllocator::getUsedCount() const {
+    return m_NextIndex - (std::uint32_t)(m_FreeIndices.size() + m_RetiredIndices.size());
+}
+
+void BindlessHeap::init(VkDevice device, VkPhysicalDevice physicalDevice, std::uint32_t framesInFlight) {
+    m_Device = device;
+    m_FramesInFlight = framesInFlight;
+
+    VkPhysicalDeviceVulkan12Properties properties12{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES,
+    };
+    VkPhysicalDeviceProperties2 properties{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+        .pNext = &properties12,
+    };
+    vkGetPhysicalDeviceProperties2(physicalDevice, &properties);
+
+    const std::uint32_t sampledImageCount = std::min(BINDLESS_MAX_SAMPLED_IMAGES, properties12.maxDescriptorSetUpdateAfterBindSampledImages);
+    const std::uint32_t samplerCount = std::min(BINDLESS_MAX_SAMPLERS, properties12.maxDescriptorSetUpdateAfterBindSamplers);
+    const std::uint32_t storageBufferCount = std::min(BINDLESS_MAX_STORAGE_BUFFERS, properties12.maxDescriptorSetUpdateAfterBindStorageBuffers);
+
+    m_SampledImages.init(sampledImageCount);
+    m_Samplers.init(samplerCount);
+    m_StorageBuffers.init(storageBufferCount);
+
+    std::array<VkDescriptorBindingFlags, 3> bindingFlags{};
+    bindingFlags.fill(VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT);
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+        .bindingCount = (std::uint32_t)bindingFlags.size(),
+        .pBindingFlags = bindingFlags.data(),
+    };
+
+    DescriptorLayoutBuilder builder{};
+    builder.addBinding(BINDLESS_SAMPLED_IMAGE_BINDING, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, sampledImageCount);
+    builder.addBinding(BINDLESS_SAMPLER_BINDING, VK_DESCRIPTOR_TYPE_SAMPLER, samplerCount);
+    builder.addBinding(BINDLESS_STORAGE_BUFFER_BINDING, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, storageBufferCount);
+    m_Layout = builder.build(
+        m_Device,
+        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT,
+        &bindingFlagsInfo,
+        VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT);
+
+    std::array<VkDescriptorPoolSize, 3> poolSizes{
+        VkDescriptorPoolSize{.type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, .descriptorCount = sampledImageCount},
+        VkDescriptorPoolSize{.type = VK_DESCRIPTOR_TYPE_SAMPLER, .descriptorCount = samplerCount},
+        VkDescriptorPoolSize{.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, .descriptorCount = storageBufferCount},
+    };
+
+    VkDescriptorPoolCreateInfo poolInfo{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+        .maxSets = 1,
+        .poolSizeCount = (std::uint32_t)poolSizes.size(),
+        .pPoolSizes = poolSizes.data(),
+    };
+    VK_CHECK(vkCreateDescriptorPool(m_Device, &poolInfo, nullptr, &m_Pool));
+
+    VkDescriptorSetAllocateInfo allocateInfo{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .descriptorPool = m_Pool,
+        .descriptorSetCount = 1,
+        .pSetLayouts = &m_Layout,
+    };
+    VK_CHECK(vkAllocateDescriptorSets(m_Device, &allocateInfo, &m_Set));
+}
+
+void BindlessHeap::destroy() {
+    m_Writer.clear();
+    vkDestroyDescriptorPool(m_Device, m_Pool, nullptr);
+    vkDestroyDescriptorSetLayout(m_Device, m_Layout, nullptr);
+
+    m_Pool = VK_NULL_HANDLE;
+    m_Layout = VK_NULL_HANDLE;
+    m_Set = VK_NULL_HANDLE;
+}
+
+void BindlessHeap::beginFrame(std::uint64_t frameNumber) {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+
+    m_FrameNumber = frameNumber;
+    if (frameNumber < m_FramesInFlight) return;
+
+    const std::uint64_t completedFrameNumber = frameNumber - m_FramesInFlight;
+    m_SampledImages.recycle(completedFrameNumber);
+    m_Samplers.recycle(completedFrameNumber);
+    m_StorageBuffers.recycle(completedFrameNumber);
+}
+
+void BindlessHeap::flush() {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    m_Writer.flush(m_Device);
+}
+
+std::uint32_t BindlessHeap::addSampledImage(VkImageView imageView, VkImageLayout imageLayout) {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+
+    const std::uint32_t index = allocateIndex(m_SampledImages, "sampled image");
+    if (index == BINDLESS_INVALID_INDEX) return index;
+
+    m_Writer.writeImage(m_Set, BINDLESS_SAMPLED_IMAGE_BINDING, imageView, VK_NULL_HANDLE, imageLayout, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, index);
+    return index;
+}
+
+std::uint32_t BindlessHeap::addSampler(VkSampler sampler) {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+
+    const std::uint32_t index = allocateIndex(m_Samplers, "sampler");
+    if (index == BINDLESS_INVALID_INDEX) return index;
+
+    m_Writer.writeImage(m_Set, BINDLESS_SAMPLER_BINDING, VK_NULL_HANDLE, sampler, VK_IMAGE_LAYOUT_UNDEFINED, VK_DESCRIPTOR_TYPE_SAMPLER, index);
+    return index;
+}
+
+std::uint32_t BindlessHeap::addStorageBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+
+    const std::uint32_t index = allocateIndex(m_StorageBuffers, "storage buffer");
+    if (index == BINDLESS_INVALID_INDEX) return index;
+
+    m_Writer.writeBuffer(m_Set, BINDLESS_STORAGE_BUFFER_BINDING, buffer, range, offset, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, index);
+    return index;
+}
+
+void BindlessHeap::removeSampledImage(std::uint32_t index) {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    m_SampledImages.release(index, m_FrameNumber);
+}
+
+void BindlessHeap::removeSampler(std::uint32_t index) {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    m_Samplers.release(index, m_FrameNumber);
+}
+
+void BindlessHeap::removeStorageBuffer(std::uint32_t index) {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    m_StorageBuffers.release(index, m_FrameNumber);
+}
+
+void BindlessHeap::bind(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout layout, std::uint32_t setIndex) const {
+    vkCmdBindDescriptorSets(commandBuffer, bindPoint, layout, setIndex, 1, &m_Set, 0, nullptr);
+}
+
+VkDescriptorSetLayout BindlessHeap::getLayout() const {
+    return m_Layout;
+}
+
+VkDescriptorSet BindlessHeap::getSet() const {
+    return m_Set;
+}
+
+std::uint32_t BindlessHeap::getSampledImageCount() const {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    return m_SampledImages.getUsedCount();
+}
+
+std::uint32_t BindlessHeap::getSamplerCount() const {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    return m_Samplers.getUsedCount();
+}
+
+std::uint32_t BindlessHeap::getStorageBufferCount() const {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    return m_StorageBuffers.getUsedCount();
+}
+
+std::uint32_t BindlessHeap::allocateIndex(BindlessIndexAllocator &allocator, const char *name) {
+    const std::uint32_t index = allocator.allocate();
+    if (index == BINDLESS_INVALID_INDEX) {
+        fmt::println("[ERROR]: Bindless heap is out of {} slots ({}).", name, allocator.getCapacity());
+    }
+    return index;
+}
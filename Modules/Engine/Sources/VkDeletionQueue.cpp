@@ -0,0 +1,93 @@
+#include <VkGuide/VkDeletionQueue.hpp>
+#include <VkGuide/VkMemoryTelemetry.hpp>
+
+template <typename T, typename Destroy>
+static std::uint32_t releaseDeletions(std::vector<DeferredDeletion<T>> &deletions, std::uint64_t frameNumber, std::uint32_t framesInFlight, Destroy &&destroy) {
+    std::size_t count = 0;
+    while (count < deletions.size() && (frameNumber == ~0ULL || deletions[count].FrameNumber + framesInFlight <= frameNumber)) {
+        destroy(deletions[count].Handle);
+        count++;
+    }
+
+    deletions.erase(deletions.begin(), deletions.begin() + (std::ptrdiff_t)count);
+    return (std::uint32_t)count;
+}
+
+template <typename T>
+static void pushDeletion(std::vector<DeferredDeletion<T>> &deletions, T &&handle, std::uint64_t frameNumber) {
+    assert(deletions.empty() || deletions.back().FrameNumber <= frameNumber);
+    deletions.emplace_back(DeferredDeletion<T>{.Handle = std::move(handle), .FrameNumber = frameNumber});
+}
+
+void DeferredDeletionQueue::init(VkDevice device, VmaAllocator allocator, MemoryTelemetry *memoryTelemetry, std::uint32_t framesInFlight) {
+    m_Device = device;
+    m_Allocator = allocator;
+    m_MemoryTelemetry = memoryTelemetry;
+    m_FramesInFlight = framesInFlight;
+}
+
+void DeferredDeletionQueue::destroy() {
+    flush(~0ULL);
+}
+
+void DeferredDeletionQueue::pushPipeline(VkPipeline pipeline, std::uint64_t frameNumber) {
+    pushDeletion(m_Pipelines, std::move(pipeline), frameNumber);
+    m_Stats.PendingCount++;
+}
+
+void DeferredDeletionQueue::pushImageView(VkImageView view, std::uint64_t frameNumber) {
+    pushDeletion(m_ImageViews, std::move(view), frameNumber);
+    m_Stats.PendingCount++;
+}
+
+void DeferredDeletionQueue::pushImage(const AllocatedImage &image, std::uint64_t frameNumber) {
+    pushDeletion(m_Images, DeferredImage{.Image = image.Image, .View = image.View, .Allocation = image.Allocation}, frameNumber);
+    m_Stats.PendingCount++;
+}
+
+void DeferredDeletionQueue::pushBuffer(const AllocatedBuffer &buffer, std::uint64_t frameNumber) {
+    pushDeletion(m_Buffers, DeferredBuffer{.Buffer = buffer.Buffer, .Allocation = buffer.Allocation}, frameNumber);
+    m_Stats.PendingCount++;
+}
+
+void DeferredDeletionQueue::pushFunction(std::function<void()> &&function, std::uint64_t frameNumber) {
+    pushDeletion(m_Functions, std::move(function), frameNumber);
+    m_Stats.PendingCount++;
+    m_Stats.FunctionCount++;
+}
+
+void DeferredDeletionQueue::flush(std::uint64_t frameNumber) {
+    if (m_Stats.PendingCount == 0) return;
+
+    std::uint32_t destroyed = 0;
+
+    destroyed += releaseDeletions(m_Functions, frameNumber, m_FramesInFlight, [](std::function<void()> &function) {
+        function();
+    });
+
+    destroyed += releaseDeletions(m_Pipelines, frameNumber, m_FramesInFlight, [this](VkPipeline pipeline) {
+        vkDestroyPipeline(m_Device, pipeline, nullptr);
+    });
+
+    destroyed += releaseDeletions(m_ImageViews, frameNumber, m_FramesInFlight, [this](VkImageView view) {
+        vkDestroyImageView(m_Device, view, nullptr);
+    });
+
+    destroyed += releaseDeletions(m_Images, frameNumber, m_FramesInFlight, [this](const DeferredImage &image) {
+        if (image.View != VK_NULL_HANDLE) vkDestroyImageView(m_Device, image.View, nullptr);
+        m_MemoryTelemetry->untrack(image.Allocation);
+        vmaDestroyImage(m_Allocator, image.Image, image.Allocation);
+    });
+
+    destroyed += releaseDeletions(m_Buffers, frameNumber, m_FramesInFlight, [this](const DeferredBuffer &buffer) {
+        m_MemoryTelemetry->untrack(buffer.Allocation);
+        vmaDestroyBuffer(m_Allocator, buffer.Buffer, buffer.Allocation);
+    });
+
+    m_Stats.PendingCount -= destroyed;
+    m_Stats.DestroyedCount += destroyed;
+}
+
+const DeferredDeletionStats &DeferredDeletionQueue::getStats() const {
+    return m_Stats;
+}
@@ -1,10 +1,14 @@
 #include <VkGuide/VkDescriptors.hpp>
 
-void DescriptorLayoutBuilder::addBinding(std::uint32_t binding, VkDescriptorType type) {
+#include <algorithm>
+
+constexpr std::uint32_t DESCRIPTOR_POOL_MAX_SETS{4092};
+
+void DescriptorLayoutBuilder::addBinding(std::uint32_t binding, VkDescriptorType type, std::uint32_t count) {
     m_Bindings.emplace_back(VkDescriptorSetLayoutBinding{
         .binding = binding,
         .descriptorType = type,
-        .descriptorCount = 1,
+        .descriptorCount = count,
     });
 }
 
@@ -34,6 +38,59 @@ VkDescriptorSetLayout DescriptorLayoutBuilder::build(
     return setLayout;
 }
 
+void DescriptorWriter::writeImage(VkDescriptorSet set, std::uint32_t binding, VkImageView imageView, VkSampler sampler, VkImageLayout layout, VkDescriptorType type, std::uint32_t arrayElement) {
+    const VkDescriptorImageInfo &info = m_ImageInfos.emplace_back(VkDescriptorImageInfo{
+        .sampler = sampler,
+        .imageView = imageView,
+        .imageLayout = layout,
+    });
+
+    m_Writes.emplace_back(VkWriteDescriptorSet{
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .dstSet = set,
+        .dstBinding = binding,
+        .dstArrayElement = arrayElement,
+        .descriptorCount = 1,
+        .descriptorType = type,
+        .pImageInfo = &info,
+    });
+}
+
+void DescriptorWriter::writeBuffer(VkDescriptorSet set, std::uint32_t binding, VkBuffer buffer, VkDeviceSize size, VkDeviceSize offset, VkDescriptorType type, std::uint32_t arrayElement) {
+    const VkDescriptorBufferInfo &info = m_BufferInfos.emplace_back(VkDescriptorBufferInfo{
+        .buffer = buffer,
+        .offset = offset,
+        .range = size,
+    });
+
+    m_Writes.emplace_back(VkWriteDescriptorSet{
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .dstSet = set,
+        .dstBinding = binding,
+        .dstArrayElement = arrayElement,
+        .descriptorCount = 1,
+        .descriptorType = type,
+        .pBufferInfo = &info,
+    });
+}
+
+void DescriptorWriter::clear() {
+    m_ImageInfos.clear();
+    m_BufferInfos.clear();
+    m_Writes.clear();
+}
+
+void DescriptorWriter::flush(VkDevice device) {
+    if (!m_Writes.empty()) {
+        vkUpdateDescriptorSets(device, (std::uint32_t)m_Writes.size(), m_Writes.data(), 0, nullptr);
+    }
+    clear();
+}
+
+std::uint32_t DescriptorWriter::getPendingCount() const {
+    return (std::uint32_t)m_Writes.size();
+}
+
 void DescriptorAllocator::initPool(VkDevice device, std::uint32_t maxSets, const std::span<PoolSizeRatio> &poolRatios) {
     assert(m_Pool == VK_NULL_HANDLE);
 
@@ -79,4 +136,98 @@ VkDescriptorSet DescriptorAllocator::allocate(VkDevice device, VkDescriptorSetLa
     VkDescriptorSet set{VK_NULL_HANDLE};
     VK_CHECK(vkAllocateDescriptorSets(device, &info, &set));
     return set;
-}
\ No newline at end of file
+}
+
+void DescriptorAllocatorGrowable::init(VkDevice device, std::uint32_t initialSets, std::span<const PoolSizeRatio> poolRatios) {
+    m_Ratios.assign(poolRatios.begin(), poolRatios.end());
+
+    m_ReadyPools.emplace_back(createPool(device, initialSets));
+    m_SetsPerPool = std::min(initialSets + initialSets / 2, DESCRIPTOR_POOL_MAX_SETS);
+}
+
+void DescriptorAllocatorGrowable::clearPools(VkDevice device) {
+    for (VkDescriptorPool pool : m_ReadyPools) {
+        vkResetDescriptorPool(device, pool, 0);
+    }
+    for (VkDescriptorPool pool : m_FullPools) {
+        vkResetDescriptorPool(device, pool, 0);
+        m_ReadyPools.emplace_back(pool);
+    }
+    m_FullPools.clear();
+}
+
+void DescriptorAllocatorGrowable::destroyPools(VkDevice device) {
+    for (VkDescriptorPool pool : m_ReadyPools) {
+        vkDestroyDescriptorPool(device, pool, nullptr);
+    }
+    for (VkDescriptorPool pool : m_FullPools) {
+        vkDestroyDescriptorPool(device, pool, nullptr);
+    }
+    m_ReadyPools.clear();
+    m_FullPools.clear();
+}
+
+VkDescriptorSet DescriptorAllocatorGrowable::allocate(VkDevice device, VkDescriptorSetLayout layout, void *pNext) {
+    VkDescriptorPool pool = getPool(device);
+
+    VkDescriptorSetAllocateInfo info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .pNext = pNext,
+        .descriptorPool = pool,
+        .descriptorSetCount = 1,
+        .pSetLayouts = &layout,
+    };
+
+    VkDescriptorSet set{VK_NULL_HANDLE};
+    VkResult result = vkAllocateDescriptorSets(device, &info, &set);
+    if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL) {
+        m_FullPools.emplace_back(pool);
+
+        pool = getPool(device);
+        info.descriptorPool = pool;
+        VK_CHECK(vkAllocateDescriptorSets(device, &info, &set));
+    } else {
+        VK_CHECK(result);
+    }
+
+    m_ReadyPools.emplace_back(pool);
+    return set;
+}
+
+std::uint32_t DescriptorAllocatorGrowable::getPoolCount() const {
+    return (std::uint32_t)(m_ReadyPools.size() + m_FullPools.size());
+}
+
+VkDescriptorPool DescriptorAllocatorGrowable::getPool(VkDevice device) {
+    if (!m_ReadyPools.empty()) {
+        VkDescriptorPool pool = m_ReadyPools.back();
+        m_ReadyPools.pop_back();
+        return pool;
+    }
+
+    VkDescriptorPool pool = createPool(device, m_SetsPerPool);
+    m_SetsPerPool = std::min(m_SetsPerPool + m_SetsPerPool / 2, DESCRIPTOR_POOL_MAX_SETS);
+    return pool;
+}
+
+VkDescriptorPool DescriptorAllocatorGrowable::createPool(VkDevice device, std::uint32_t setCount) const {
+    std::vector<VkDescriptorPoolSize> poolSizes{};
+    poolSizes.reserve(m_Ratios.size());
+    for (const PoolSizeRatio &ratio : m_Ratios) {
+        poolSizes.emplace_back(VkDescriptorPoolSize{
+            .type = ratio.Type,
+            .descriptorCount = std::max(std::uint32_t(ratio.Ratio * setCount), 1U),
+        });
+    }
+
+    VkDescriptorPoolCreateInfo info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .maxSets = setCount,
+        .poolSizeCount = (std::uint32_t)poolSizes.size(),
+        .pPoolSizes = poolSizes.data(),
+    };
+
+    VkDescriptorPool pool{VK_NULL_HANDLE};
+    VK_CHECK(vkCreateDescriptorPool(device, &info, nullptr, &pool));
+    return pool;
+}
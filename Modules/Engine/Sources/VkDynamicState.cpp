@@ -0,0 +1,91 @@
+#include <VkGuide/VkDynamicState.hpp>
+
+#include <cstring>
+
+void DynamicStateTracker::init(VkDevice device, DynamicStateFlags supportedFlags) {
+    m_SupportedFlags = supportedFlags;
+
+    if (m_SupportedFlags & DYNAMIC_STATE_BLEND) {
+        m_CmdSetColorBlendEnable = (PFN_vkCmdSetColorBlendEnableEXT)vkGetDeviceProcAddr(device, "vkCmdSetColorBlendEnableEXT");
+        m_CmdSetColorBlendEquation = (PFN_vkCmdSetColorBlendEquationEXT)vkGetDeviceProcAddr(device, "vkCmdSetColorBlendEquationEXT");
+        m_CmdSetColorWriteMask = (PFN_vkCmdSetColorWriteMaskEXT)vkGetDeviceProcAddr(device, "vkCmdSetColorWriteMaskEXT");
+
+        if (m_CmdSetColorBlendEnable == nullptr || m_CmdSetColorBlendEquation == nullptr || m_CmdSetColorWriteMask == nullptr) {
+            fmt::println("[ERROR]: Failed to load VK_EXT_extended_dynamic_state3 blend commands.");
+            m_SupportedFlags &= ~DYNAMIC_STATE_BLEND;
+        }
+    }
+}
+
+void DynamicStateTracker::begin(VkCommandBuffer commandBuffer) {
+    m_CommandBuffer = commandBuffer;
+    m_IsValid = false;
+    m_SetCount = 0;
+    m_SkippedCount = 0;
+}
+
+void DynamicStateTracker::apply(const PipelineDynamicState &state) {
+    assert(m_CommandBuffer != VK_NULL_HANDLE);
+
+    if (m_SupportedFlags & DYNAMIC_STATE_RASTERIZATION) {
+        set(m_State.CullMode, state.CullMode, [this](VkCullModeFlags value) {
+            vkCmdSetCullMode(m_CommandBuffer, value);
+        });
+        set(m_State.FrontFace, state.FrontFace, [this](VkFrontFace value) {
+            vkCmdSetFrontFace(m_CommandBuffer, value);
+        });
+        set(m_State.Topology, state.Topology, [this](VkPrimitiveTopology value) {
+            vkCmdSetPrimitiveTopology(m_CommandBuffer, value);
+        });
+    }
+
+    if (m_SupportedFlags & DYNAMIC_STATE_DEPTH) {
+        set(m_State.DepthTestEnable, state.DepthTestEnable, [this](VkBool32 value) {
+            vkCmdSetDepthTestEnable(m_CommandBuffer, value);
+        });
+        set(m_State.DepthWriteEnable, state.DepthWriteEnable, [this](VkBool32 value) {
+            vkCmdSetDepthWriteEnable(m_CommandBuffer, value);
+        });
+        set(m_State.DepthCompareOp, state.DepthCompareOp, [this](VkCompareOp value) {
+            vkCmdSetDepthCompareOp(m_CommandBuffer, value);
+        });
+    }
+
+    if (m_SupportedFlags & DYNAMIC_STATE_BLEND) {
+        set(m_State.BlendEnable, state.BlendEnable, [this](VkBool32 value) {
+            m_CmdSetColorBlendEnable(m_CommandBuffer, 0, 1, &value);
+        });
+        set(m_State.BlendEquation, state.BlendEquation, [this](const VkColorBlendEquationEXT &value) {
+            m_CmdSetColorBlendEquation(m_CommandBuffer, 0, 1, &value);
+        });
+        set(m_State.ColorWriteMask, state.ColorWriteMask, [this](VkColorComponentFlags value) {
+            m_CmdSetColorWriteMask(m_CommandBuffer, 0, 1, &value);
+        });
+    }
+
+    m_IsValid = true;
+}
+
+DynamicStateFlags DynamicStateTracker::getSupportedFlags() const {
+    return m_SupportedFlags;
+}
+
+std::uint32_t DynamicStateTracker::getSetCount() const {
+    return m_SetCount;
+}
+
+std::uint32_t DynamicStateTracker::getSkippedCount() const {
+    return m_SkippedCount;
+}
+
+template <typename T, typename Function>
+void DynamicStateTracker::set(T &current, const T &value, Function &&function) {
+    if (m_IsValid && std::memcmp(&current, &value, sizeof(T)) == 0) {
+        m_SkippedCount++;
+        return;
+    }
+
+    current = value;
+    function(value);
+    m_SetCount++;
+}
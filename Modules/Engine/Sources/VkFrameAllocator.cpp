@@ -0,0 +1,97 @@
+#include <VkGuide/VkFrameAllocator.hpp>
+#include <VkGuide/VkMemoryTelemetry.hpp>
+
+#include <algorithm>
+
+void FrameAllocator::init(VkDevice device, VmaAllocator allocator, MemoryTelemetry *memoryTelemetry, VkDeviceSize capacity, VkDeviceSize alignment) {
+    m_Allocator = allocator;
+    m_MemoryTelemetry = memoryTelemetry;
+    m_Alignment = std::max(alignment, FRAME_ALLOCATOR_MIN_ALIGNMENT);
+    assert((m_Alignment & (m_Alignment - 1)) == 0);
+
+    VkBufferCreateInfo bufferInfo{
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = capacity,
+        .usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                 VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
+                 VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                 VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+    };
+
+    VmaAllocationCreateInfo allocationInfo{
+        .flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
+        .usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+    };
+
+    VK_CHECK(vmaCreateBuffer(m_Allocator, &bufferInfo, &allocationInfo, &m_Buffer.Buffer, &m_Buffer.Allocation, &m_Buffer.Info));
+    m_MemoryTelemetry->track(m_Buffer.Allocation, MemoryCategory::Frame);
+
+    VkMemoryPropertyFlags memoryProperties = 0;
+    vmaGetAllocationMemoryProperties(m_Allocator, m_Buffer.Allocation, &memoryProperties);
+
+    VkBufferDeviceAddressInfo deviceAddressInfo{
+        .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+        .buffer = m_Buffer.Buffer,
+    };
+    m_Address = vkGetBufferDeviceAddress(device, &deviceAddressInfo);
+
+    m_Stats = FrameAllocatorStats{
+        .Capacity = capacity,
+        .IsDeviceLocal = (memoryProperties & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) != 0,
+    };
+}
+
+void FrameAllocator::destroy() {
+    if (m_Buffer.Buffer == VK_NULL_HANDLE) return;
+
+    m_MemoryTelemetry->untrack(m_Buffer.Allocation);
+    vmaDestroyBuffer(m_Allocator, m_Buffer.Buffer, m_Buffer.Allocation);
+    m_Buffer = AllocatedBuffer{};
+    m_Address = 0;
+}
+
+void FrameAllocator::reset() {
+    m_Offset = 0;
+    m_Stats.UsedBytes = 0;
+    m_Stats.AllocationCount = 0;
+}
+
+std::optional<FrameAllocation> FrameAllocator::allocate(VkDeviceSize size, VkDeviceSize alignment) {
+    alignment = std::max(alignment, m_Alignment);
+    assert((alignment & (alignment - 1)) == 0);
+
+    if (size == 0) return std::nullopt;
+
+    const VkDeviceSize offset = (m_Offset + alignment - 1) & ~(alignment - 1);
+    if (offset + size > m_Stats.Capacity) {
+        m_Stats.FailedCount++;
+        return std::nullopt;
+    }
+
+    m_Offset = offset + size;
+    m_Stats.UsedBytes = m_Offset;
+    m_Stats.PeakBytes = std::max(m_Stats.PeakBytes, m_Offset);
+    m_Stats.AllocationCount++;
+
+    return FrameAllocation{
+        .Data = (char *)m_Buffer.Info.pMappedData + offset,
+        .Buffer = m_Buffer.Buffer,
+        .Offset = offset,
+        .Size = size,
+        .Address = m_Address + offset,
+    };
+}
+
+void FrameAllocator::flush() {
+    if (m_Offset == 0) return;
+
+    VK_CHECK(vmaFlushAllocation(m_Allocator, m_Buffer.Allocation, 0, m_Offset));
+}
+
+VkBuffer FrameAllocator::getBuffer() const {
+    return m_Buffer.Buffer;
+}
+
+const FrameAllocatorStats &FrameAllocator::getStats() const {
+    return m_Stats;
+}
@@ -0,0 +1,126 @@
+#include <VkGuide/VkFrameArena.hpp>
+#include <VkGuide/VkJobs.hpp>
+
+#include <algorithm>
+
+void LinearArena::init(std::size_t capacity) {
+    m_Blocks.clear();
+    pushBlock(capacity);
+
+    m_Offset = 0;
+    m_RetiredBytes = 0;
+    m_Stats = FrameArenaStats{.Capacity = capacity};
+}
+
+void LinearArena::destroy() {
+    m_Blocks.clear();
+    m_Offset = 0;
+    m_RetiredBytes = 0;
+    m_Stats = FrameArenaStats{};
+}
+
+void LinearArena::reset() {
+    if (m_Blocks.size() > 1) {
+        std::size_t capacity = 0;
+        for (const Block &block : m_Blocks) {
+            capacity += block.Size;
+        }
+
+        m_Blocks.clear();
+        pushBlock(capacity);
+        m_Stats.Capacity = capacity;
+    }
+
+    m_Offset = 0;
+    m_RetiredBytes = 0;
+    m_Stats.UsedBytes = 0;
+    m_Stats.AllocationCount = 0;
+    m_Stats.HeapAllocationCount = 0;
+}
+
+const FrameArenaStats &LinearArena::getStats() const {
+    return m_Stats;
+}
+
+void *LinearArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    assert(!m_Blocks.empty());
+
+    std::uintptr_t base = (std::uintptr_t)m_Blocks.back().Data.get();
+    std::uintptr_t address = (base + m_Offset + alignment - 1) & ~(std::uintptr_t)(alignment - 1);
+
+    if (address + bytes > base + m_Blocks.back().Size) {
+        m_RetiredBytes += m_Offset;
+        pushBlock(std::max(m_Blocks.back().Size * 2, bytes + alignment));
+        m_Stats.HeapAllocationCount++;
+
+        base = (std::uintptr_t)m_Blocks.back().Data.get();
+        address = (base + alignment - 1) & ~(std::uintptr_t)(alignment - 1);
+    }
+
+    m_Offset = address - base + bytes;
+
+    m_Stats.UsedBytes = m_RetiredBytes + m_Offset;
+    m_Stats.HighWaterMark = std::max(m_Stats.HighWaterMark, m_Stats.UsedBytes);
+    m_Stats.AllocationCount++;
+
+    return (void *)address;
+}
+
+void LinearArena::do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) {
+}
+
+bool LinearArena::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+    return this == &other;
+}
+
+void LinearArena::pushBlock(std::size_t size) {
+    m_Blocks.emplace_back(Block{
+        .Data = std::unique_ptr<std::byte[]>(new std::byte[size]),
+        .Size = size,
+    });
+    m_Offset = 0;
+}
+
+void FrameArena::init(std::uint32_t workerCount, std::size_t capacity, std::size_t workerCapacity) {
+    m_Arenas.clear();
+    m_Arenas.reserve(workerCount + 1);
+    for (std::uint32_t i = 0; i <= workerCount; i++) {
+        m_Arenas.emplace_back(std::make_unique<LinearArena>())->init(i == 0 ? capacity : workerCapacity);
+    }
+}
+
+void FrameArena::destroy() {
+    for (std::unique_ptr<LinearArena> &arena : m_Arenas) {
+        arena->destroy();
+    }
+}
+
+void FrameArena::reset() {
+    for (std::unique_ptr<LinearArena> &arena : m_Arenas) {
+        arena->reset();
+    }
+}
+
+std::pmr::memory_resource *FrameArena::getResource() {
+    // Threads outside the job system have no arena of their own and would race with the main thread on arena 0.
+    assert(JobSystem::GetCurrentWorkerIndex() != JOB_WORKER_INDEX_NONE);
+    return getWorkerResource(JobSystem::GetCurrentWorkerIndex());
+}
+
+std::pmr::memory_resource *FrameArena::getWorkerResource(std::uint32_t workerIndex) {
+    assert(workerIndex < m_Arenas.size());
+    return m_Arenas[workerIndex].get();
+}
+
+FrameArenaStats FrameArena::getStats() const {
+    FrameArenaStats stats{};
+    for (const std::unique_ptr<LinearArena> &arena : m_Arenas) {
+        const FrameArenaStats &arenaStats = arena->getStats();
+        stats.Capacity += arenaStats.Capacity;
+        stats.UsedBytes += arenaStats.UsedBytes;
+        stats.HighWaterMark += arenaStats.HighWaterMark;
+        stats.AllocationCount += arenaStats.AllocationCount;
+        stats.HeapAllocationCount += arenaStats.HeapAllocationCount;
+    }
+    return stats;
+}
@@ -0,0 +1,132 @@
+#include <VkGuide/VkJobs.hpp>
+
+#include <algorithm>
+#include <latch>
+
+static thread_local std::uint32_t g_WorkerIndex{JOB_WORKER_INDEX_NONE};
+
+void JobSystem::init(std::uint32_t workerCount) {
+    assert(!m_Running);
+
+    if (workerCount == 0) {
+        std::uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    g_WorkerIndex = 0;
+
+    m_Running = true;
+    m_Workers.reserve(workerCount);
+    for (std::uint32_t i = 0; i < workerCount; i++) {
+        m_Workers.emplace_back(&JobSystem::workerLoop, this, i + 1);
+    }
+}
+
+void JobSystem::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock{m_Mutex};
+        m_Running = false;
+    }
+    m_Condition.notify_all();
+
+    for (std::thread &worker : m_Workers) {
+        worker.join();
+    }
+
+    m_Workers.clear();
+    m_Jobs.clear();
+}
+
+void JobSystem::parallelFor(std::uint32_t count, std::uint32_t batchSize, const std::function<void(std::uint32_t begin, std::uint32_t end)> &function) {
+    if (count == 0) return;
+
+    batchSize = std::max(batchSize, 1U);
+    const std::uint32_t batchCount = (count + batchSize - 1) / batchSize;
+    const std::uint32_t helperCount = std::min(batchCount - 1, (std::uint32_t)m_Workers.size());
+
+    if (helperCount == 0) {
+        function(0, count);
+        return;
+    }
+
+    const std::uint32_t group = createGroup();
+    std::atomic<std::uint32_t> nextBatch{0};
+    std::latch helpersDone{(std::ptrdiff_t)helperCount};
+
+    auto runBatches = [&]() {
+        for (std::uint32_t batch = nextBatch.fetch_add(1); batch < batchCount; batch = nextBatch.fetch_add(1)) {
+            const std::uint32_t begin = batch * batchSize;
+            function(begin, std::min(begin + batchSize, count));
+        }
+    };
+
+    {
+        std::lock_guard<std::mutex> lock{m_Mutex};
+        for (std::uint32_t i = 0; i < helperCount; i++) {
+            m_Jobs.emplace_back(Job{
+                .Function = [&]() {
+                    runBatches();
+                    helpersDone.count_down();
+                },
+                .Group = group,
+            });
+        }
+    }
+    m_Condition.notify_all();
+
+    runBatches();
+
+    while (!helpersDone.try_wait()) {
+        if (!runPendingJob(group)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+std::uint32_t JobSystem::createGroup() {
+    return m_NextGroup.fetch_add(1);
+}
+
+bool JobSystem::runPendingJob(std::uint32_t group) {
+    assert(group != JOB_GROUP_NONE);
+
+    std::function<void()> job{};
+    {
+        std::lock_guard<std::mutex> lock{m_Mutex};
+        std::deque<Job>::iterator it = std::find_if(m_Jobs.begin(), m_Jobs.end(), [group](const Job &pending) { return pending.Group == group; });
+        if (it == m_Jobs.end()) return false;
+
+        job = std::move(it->Function);
+        m_Jobs.erase(it);
+    }
+
+    job();
+    return true;
+}
+
+std::uint32_t JobSystem::getWorkerCount() const {
+    return (std::uint32_t)m_Workers.size();
+}
+
+std::uint32_t JobSystem::GetCurrentWorkerIndex() {
+    return g_WorkerIndex;
+}
+
+void JobSystem::workerLoop(std::uint32_t workerIndex) {
+    g_WorkerIndex = workerIndex;
+
+    while (true) {
+        std::function<void()> job{};
+        {
+            std::unique_lock<std::mutex> lock{m_Mutex};
+            m_Condition.wait(lock, [this]() { return !m_Running || !m_Jobs.empty(); });
+
+            if (!m_Running && m_Jobs.empty()) return;
+
+            job = std::move(m_Jobs.front().Function);
+            m_Jobs.pop_front();
+        }
+
+        job();
+    }
+}
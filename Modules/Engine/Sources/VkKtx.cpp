@@ -0,0 +1,234 @@
+#include <VkGuide/VkKtx.hpp>
+#include <VkGuide/VkTextureCompression.hpp>
+#include <VkGuide/VkUtils.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+struct DataFormatSample {
+    std::uint32_t BitOffset;
+    std::uint32_t BitLength;
+    std::uint32_t Channel;
+    std::uint32_t Upper;
+};
+
+static std::vector<std::uint32_t> getDataFormatDescriptor(VkFormat format) {
+    std::uint32_t colorModel = 0;
+    std::uint32_t blockDimensions = 0;
+    std::vector<DataFormatSample> samples{};
+
+    switch (format) {
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+            colorModel = 1;
+            samples = {{0, 8, 0, 0xFF}, {8, 8, 1, 0xFF}, {16, 8, 2, 0xFF}, {24, 8, 15, 0xFF}};
+            break;
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+            colorModel = 128;
+            blockDimensions = 0x0303;
+            samples = {{0, 64, 0, ~0U}};
+            break;
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:
+            colorModel = 130;
+            blockDimensions = 0x0303;
+            samples = {{0, 64, 15, ~0U}, {64, 64, 0, ~0U}};
+            break;
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+            colorModel = 132;
+            blockDimensions = 0x0303;
+            samples = {{0, 64, 0, ~0U}, {64, 64, 1, ~0U}};
+            break;
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_BC7_SRGB_BLOCK:
+            colorModel = 134;
+            blockDimensions = 0x0303;
+            samples = {{0, 128, 0, ~0U}};
+            break;
+        default:
+            return {};
+    }
+
+    const bool isSrgb = vkutils::IsSrgbFormat(format);
+    const std::uint32_t blockSize = 24 + 16 * (std::uint32_t)samples.size();
+
+    std::vector<std::uint32_t> descriptor{
+        4 + blockSize,
+        0,
+        2 | (blockSize << 16),
+        colorModel | (1 << 8) | ((isSrgb ? 2U : 1U) << 16),
+        blockDimensions,
+        vkutils::GetBlockByteSize(format),
+        0,
+    };
+
+    for (const DataFormatSample &sample : samples) {
+        const std::uint32_t channelType = sample.Channel | ((isSrgb && sample.Channel == 15) ? 0x10 : 0);
+        descriptor.insert(descriptor.end(), {sample.BitOffset | ((sample.BitLength - 1) << 16) | (channelType << 24), 0, 0, sample.Upper});
+    }
+
+    return descriptor;
+}
+
+namespace vkutils {
+    bool IsKtx2(std::span<const std::uint8_t> bytes) {
+        return bytes.size() >= KTX2_IDENTIFIER.size() && std::memcmp(bytes.data(), KTX2_IDENTIFIER.data(), KTX2_IDENTIFIER.size()) == 0;
+    }
+
+    std::optional<DecodedTexture> ReadKtx2(std::span<const std::uint8_t> bytes) {
+        if (!IsKtx2(bytes) || bytes.size() < sizeof(Ktx2Header)) {
+            fmt::println("[ERROR]: Data is not a valid KTX2 texture.");
+            return std::nullopt;
+        }
+
+        Ktx2Header header{};
+        std::memcpy(&header, bytes.data(), sizeof(header));
+
+        if (header.SupercompressionScheme != 0) {
+            fmt::println("[ERROR]: Supercompressed KTX2 textures are not supported (scheme {}).", header.SupercompressionScheme);
+            return std::nullopt;
+        }
+
+        if (header.PixelWidth == 0 || header.PixelHeight == 0 || header.PixelDepth > 1 || header.LayerCount > 1 || header.FaceCount != 1) {
+            fmt::println("[ERROR]: Only 2D KTX2 textures are supported.");
+            return std::nullopt;
+        }
+
+        const VkFormat format = (VkFormat)header.Format;
+        if (GetBlockByteSize(format) == 0) {
+            fmt::println("[ERROR]: Unsupported KTX2 texture format {}.", string_VkFormat(format));
+            return std::nullopt;
+        }
+
+        const std::uint32_t levelCount = std::max(header.LevelCount, 1U);
+        if (levelCount > vkutils::GetMipLevelCount(VkExtent2D{header.PixelWidth, header.PixelHeight})) {
+            fmt::println("[ERROR]: KTX2 texture has {} levels, more than a {}x{} image allows.", levelCount, header.PixelWidth, header.PixelHeight);
+            return std::nullopt;
+        }
+        if (sizeof(Ktx2Header) + (std::size_t)levelCount * sizeof(Ktx2LevelIndex) > bytes.size()) {
+            fmt::println("[ERROR]: KTX2 level index is truncated.");
+            return std::nullopt;
+        }
+
+        std::vector<Ktx2LevelIndex> levelIndices(levelCount);
+        std::memcpy(levelIndices.data(), bytes.data() + sizeof(Ktx2Header), levelCount * sizeof(Ktx2LevelIndex));
+
+        DecodedTexture texture{
+            .Extent = VkExtent2D{header.PixelWidth, header.PixelHeight},
+            .Format = format,
+        };
+        texture.Levels.reserve(levelCount);
+
+        VkDeviceSize totalSize = 0;
+        VkExtent2D extent = texture.Extent;
+        for (std::uint32_t level = 0; level < levelCount; level++) {
+            const Ktx2LevelIndex &levelIndex = levelIndices[level];
+            const VkDeviceSize size = GetLevelByteSize(format, extent);
+
+            if (levelIndex.ByteLength < size || levelIndex.ByteOffset > bytes.size() || levelIndex.ByteLength > bytes.size() - levelIndex.ByteOffset) {
+                fmt::println("[ERROR]: KTX2 level {} is out of bounds.", level);
+                return std::nullopt;
+            }
+
+            texture.Levels.emplace_back(TextureLevel{.Offset = totalSize, .Size = size, .Extent = extent});
+
+            totalSize += size;
+            extent = VkExtent2D{std::max(extent.width / 2, 1U), std::max(extent.height / 2, 1U)};
+        }
+
+        texture.Pixels.resize(totalSize);
+        for (std::uint32_t level = 0; level < levelCount; level++) {
+            const TextureLevel &textureLevel = texture.Levels[level];
+            std::memcpy(texture.Pixels.data() + textureLevel.Offset, bytes.data() + levelIndices[level].ByteOffset, textureLevel.Size);
+        }
+
+        return texture;
+    }
+
+    bool WriteKtx2(const std::filesystem::path &filePath, const DecodedTexture &texture) {
+        const std::vector<std::uint32_t> descriptor = getDataFormatDescriptor(texture.Format);
+        if (descriptor.empty()) {
+            fmt::println("[ERROR]: Cannot describe texture format {} in KTX2.", string_VkFormat(texture.Format));
+            return false;
+        }
+
+        std::vector<TextureLevel> levels = texture.Levels;
+        if (levels.empty()) {
+            levels.emplace_back(TextureLevel{.Offset = 0, .Size = texture.Pixels.size(), .Extent = texture.Extent});
+        }
+
+        const std::uint32_t levelCount = (std::uint32_t)levels.size();
+        const std::uint64_t descriptorOffset = sizeof(Ktx2Header) + levelCount * sizeof(Ktx2LevelIndex);
+        const std::uint64_t descriptorLength = descriptor.size() * sizeof(std::uint32_t);
+
+        std::vector<Ktx2LevelIndex> levelIndices(levelCount);
+        std::uint64_t offset = descriptorOffset + descriptorLength;
+        for (std::uint32_t level = levelCount; level-- > 0;) {
+            offset = (offset + KTX2_LEVEL_ALIGNMENT - 1) & ~(KTX2_LEVEL_ALIGNMENT - 1);
+            levelIndices[level] = Ktx2LevelIndex{
+                .ByteOffset = offset,
+                .ByteLength = levels[level].Size,
+                .UncompressedByteLength = levels[level].Size,
+            };
+            offset += levels[level].Size;
+        }
+
+        const Ktx2Header header{
+            .Identifier = KTX2_IDENTIFIER,
+            .Format = (std::uint32_t)texture.Format,
+            .TypeSize = 1,
+            .PixelWidth = texture.Extent.width,
+            .PixelHeight = texture.Extent.height,
+            .PixelDepth = 0,
+            .LayerCount = 0,
+            .FaceCount = 1,
+            .LevelCount = levelCount,
+            .SupercompressionScheme = 0,
+            .DfdByteOffset = (std::uint32_t)descriptorOffset,
+            .DfdByteLength = (std::uint32_t)descriptorLength,
+            .KvdByteOffset = 0,
+            .KvdByteLength = 0,
+            .SgdByteOffset = 0,
+            .SgdByteLength = 0,
+        };
+
+        static std::atomic<std::uint32_t> tempCounter{0};
+
+        std::filesystem::path tempPath = filePath;
+        tempPath += fmt::format(".{:x}.{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()), tempCounter++);
+
+        std::ofstream file{tempPath, std::ios::binary | std::ios::trunc};
+        if (!file.is_open()) {
+            fmt::println("[ERROR]: Failed to create texture file: {}.", tempPath.string());
+            return false;
+        }
+
+        file.write((const char *)&header, sizeof(header));
+        file.write((const char *)levelIndices.data(), levelIndices.size() * sizeof(Ktx2LevelIndex));
+        file.write((const char *)descriptor.data(), descriptorLength);
+        for (std::uint32_t level = 0; level < levelCount; level++) {
+            file.seekp(levelIndices[level].ByteOffset);
+            file.write((const char *)texture.Pixels.data() + levels[level].Offset, levels[level].Size);
+        }
+        file.close();
+
+        std::error_code error{};
+        if (!file) {
+            fmt::println("[ERROR]: Failed to write texture file: {}.", tempPath.string());
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+
+        std::filesystem::rename(tempPath, filePath, error);
+        if (error) {
+            fmt::println("[ERROR]: Failed to replace texture file: {}.", filePath.string());
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+        return true;
+    }
+}  // namespace vkutils
@@ -2,8 +2,7 @@
 #include <VkGuide/VkInits.hpp>
 #include <VkGuide/VkLoader.hpp>
 #include <VkGuide/VkTypes.hpp>
-
-#include <stb_image.h>
+#include <VkGuide/VkTextures.hpp>
 
 #include <fastgltf/glm_element_traits.hpp>
 #include <fastgltf/core.hpp>
@@ -12,10 +11,14 @@
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/quaternion.hpp>
+#include <glm/gtx/matrix_decompose.hpp>
+#include <glm/geometric.hpp>
 
+#include <cmath>
 #include <iostream>
+#include <variant>
 
-std::optional<std::vector<std::shared_ptr<MeshAsset>>> loadGltfMeshes(class VulkanEngine *engine, std::filesystem::path filePath) {
+static std::optional<fastgltf::Asset> parseGltf(const std::filesystem::path &filePath) {
     std::cout << "Loading gltf: " << filePath << std::endl;
 
     fastgltf::GltfDataBuffer data{};
@@ -33,6 +36,50 @@ std::optional<std::vector<std::shared_ptr<MeshAsset>>> loadGltfMeshes(class Vulk
     }
     gltf = std::move(load.get());
 
+    return gltf;
+}
+
+static std::int32_t getBaseColorImage(const fastgltf::Asset &gltf, const fastgltf::Primitive &primitive) {
+    if (!primitive.materialIndex.has_value()) return SURFACE_NO_IMAGE;
+
+    const fastgltf::Material &material = gltf.materials[primitive.materialIndex.value()];
+    if (!material.pbrData.baseColorTexture.has_value()) return SURFACE_NO_IMAGE;
+
+    const fastgltf::Texture &texture = gltf.textures[material.pbrData.baseColorTexture->textureIndex];
+    return texture.imageIndex.has_value() ? (std::int32_t)texture.imageIndex.value() : SURFACE_NO_IMAGE;
+}
+
+static std::int32_t getBaseColorSampler(const fastgltf::Asset &gltf, const fastgltf::Primitive &primitive) {
+    if (!primitive.materialIndex.has_value()) return SURFACE_NO_SAMPLER;
+
+    const fastgltf::Material &material = gltf.materials[primitive.materialIndex.value()];
+    if (!material.pbrData.baseColorTexture.has_value()) return SURFACE_NO_SAMPLER;
+
+    const fastgltf::Texture &texture = gltf.textures[material.pbrData.baseColorTexture->textureIndex];
+    return texture.samplerIndex.has_value() ? (std::int32_t)texture.samplerIndex.value() : SURFACE_NO_SAMPLER;
+}
+
+static float getUvDensity(std::span<const std::uint32_t> indices, const std::vector<Vertex> &vertices) {
+    double uvArea = 0.0;
+    double worldArea = 0.0;
+
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const Vertex &v0 = vertices[indices[i]];
+        const Vertex &v1 = vertices[indices[i + 1]];
+        const Vertex &v2 = vertices[indices[i + 2]];
+
+        worldArea += 0.5 * glm::length(glm::cross(v1.Position - v0.Position, v2.Position - v0.Position));
+
+        const glm::vec2 uv0{v1.UvX - v0.UvX, v1.UvY - v0.UvY};
+        const glm::vec2 uv1{v2.UvX - v0.UvX, v2.UvY - v0.UvY};
+        uvArea += 0.5 * std::abs(uv0.x * uv1.y - uv0.y * uv1.x);
+    }
+
+    if (worldArea <= 0.0) return 0.0f;
+    return (float)std::sqrt(uvArea / worldArea);
+}
+
+static std::vector<std::shared_ptr<MeshAsset>> loadMeshes(VulkanEngine *engine, const fastgltf::Asset &gltf) {
     std::vector<std::shared_ptr<MeshAsset>> meshes{};
 
     std::vector<std::uint32_t> indices{};
@@ -50,6 +97,8 @@ std::optional<std::vector<std::shared_ptr<MeshAsset>>> loadGltfMeshes(class Vulk
             GeoSurface newSurface{};
             newSurface.StartIndex = (std::uint32_t)indices.size();
             newSurface.Count = (std::uint32_t)gltf.accessors[p.indicesAccessor.value()].count;
+            newSurface.ImageIndex = getBaseColorImage(gltf, p);
+            newSurface.SamplerIndex = getBaseColorSampler(gltf, p);
 
             std::size_t initialVertex = vertices.size();
 
@@ -109,6 +158,8 @@ std::optional<std::vector<std::shared_ptr<MeshAsset>>> loadGltfMeshes(class Vulk
                     });
             }
 
+            newSurface.UvDensity = getUvDensity(std::span<const std::uint32_t>{indices}.subspan(newSurface.StartIndex), vertices);
+
             newMesh.Surfaces.emplace_back(newSurface);
         }
 
@@ -119,9 +170,195 @@ std::optional<std::vector<std::shared_ptr<MeshAsset>>> loadGltfMeshes(class Vulk
             }
         }
 
-        newMesh.MeshBuffers = engine->createMesh(indices, vertices);
+        newMesh.Mesh = engine->createMesh(indices, vertices);
         meshes.emplace_back(std::make_shared<MeshAsset>(std::move(newMesh)));
     }
 
     return meshes;
+}
+
+static VkFilter getFilter(fastgltf::Filter filter) {
+    switch (filter) {
+        case fastgltf::Filter::Nearest:
+        case fastgltf::Filter::NearestMipMapNearest:
+        case fastgltf::Filter::NearestMipMapLinear:
+            return VK_FILTER_NEAREST;
+        default:
+            return VK_FILTER_LINEAR;
+    }
+}
+
+static VkSamplerMipmapMode getMipmapMode(fastgltf::Filter filter) {
+    switch (filter) {
+        case fastgltf::Filter::NearestMipMapNearest:
+        case fastgltf::Filter::LinearMipMapNearest:
+            return VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        default:
+            return VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    }
+}
+
+static VkSamplerAddressMode getAddressMode(fastgltf::Wrap wrap) {
+    switch (wrap) {
+        case fastgltf::Wrap::ClampToEdge:
+            return VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        case fastgltf::Wrap::MirroredRepeat:
+            return VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
+        default:
+            return VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    }
+}
+
+static std::vector<std::uint32_t> loadSamplers(VulkanEngine *engine, const fastgltf::Asset &gltf) {
+    std::vector<std::uint32_t> samplers{};
+    samplers.reserve(gltf.samplers.size());
+
+    for (const fastgltf::Sampler &sampler : gltf.samplers) {
+        samplers.emplace_back(engine->getSamplerIndex(SamplerKey{
+            .MagFilter = getFilter(sampler.magFilter.value_or(fastgltf::Filter::Linear)),
+            .MinFilter = getFilter(sampler.minFilter.value_or(fastgltf::Filter::Linear)),
+            .MipmapMode = getMipmapMode(sampler.minFilter.value_or(fastgltf::Filter::Linear)),
+            .AddressModeU = getAddressMode(sampler.wrapS),
+            .AddressModeV = getAddressMode(sampler.wrapT),
+        }));
+    }
+
+    return samplers;
+}
+
+static std::vector<std::uint32_t> loadImages(VulkanEngine *engine, const fastgltf::Asset &gltf, const std::filesystem::path &directory) {
+    std::vector<TextureSource> sources(gltf.images.size());
+    auto markImage = [&](const auto &textureInfo, VkFormat format, bool isNormalMap) {
+        if (!textureInfo.has_value()) return;
+
+        const fastgltf::Texture &texture = gltf.textures[textureInfo->textureIndex];
+        if (!texture.imageIndex.has_value()) return;
+
+        TextureSource &source = sources[texture.imageIndex.value()];
+        source.Format = format;
+        source.IsNormalMap = isNormalMap;
+    };
+    for (const fastgltf::Material &material : gltf.materials) {
+        markImage(material.pbrData.baseColorTexture, VK_FORMAT_R8G8B8A8_SRGB, false);
+        markImage(material.emissiveTexture, VK_FORMAT_R8G8B8A8_SRGB, false);
+        markImage(material.normalTexture, VK_FORMAT_R8G8B8A8_UNORM, true);
+    }
+
+    for (std::size_t i = 0; i < gltf.images.size(); i++) {
+        const fastgltf::Image &image = gltf.images[i];
+
+        TextureSource &source = sources[i];
+        source.Name = image.name;
+
+        std::visit(
+            fastgltf::visitor{
+                [](const auto &) {},
+                [&](const fastgltf::sources::URI &uri) {
+                    if (uri.fileByteOffset != 0 || !uri.uri.isLocalPath()) return;
+                    source.FilePath = directory / std::string{uri.uri.path().begin(), uri.uri.path().end()};
+                },
+                [&](const fastgltf::sources::Vector &vector) {
+                    source.Bytes = std::span<const std::uint8_t>{vector.bytes.data(), vector.bytes.size()};
+                },
+                [&](const fastgltf::sources::BufferView &view) {
+                    const fastgltf::BufferView &bufferView = gltf.bufferViews[view.bufferViewIndex];
+                    const fastgltf::Buffer &buffer = gltf.buffers[bufferView.bufferIndex];
+
+                    std::visit(
+                        fastgltf::visitor{
+                            [](const auto &) {},
+                            [&](const fastgltf::sources::Vector &vector) {
+                                source.Bytes = std::span<const std::uint8_t>{vector.bytes.data() + bufferView.byteOffset, bufferView.byteLength};
+                            },
+                        },
+                        buffer.data);
+                },
+            },
+            image.data);
+    }
+
+    return engine->createStreamedTextures(sources);
+}
+
+static void getNodeTransform(const fastgltf::Node &node, SceneGraph::NodeDescription &description) {
+    std::visit(
+        fastgltf::visitor{
+            [&](const fastgltf::Node::TransformMatrix &matrix) {
+                glm::mat4 localMatrix{};
+                memcpy(&localMatrix, matrix.data(), sizeof(matrix));
+
+                glm::vec3 skew{};
+                glm::vec4 perspective{};
+                glm::decompose(localMatrix, description.Scale, description.Rotation, description.Translation, skew, perspective);
+            },
+            [&](const fastgltf::Node::TRS &transform) {
+                description.Translation = glm::vec3{transform.translation[0], transform.translation[1], transform.translation[2]};
+                description.Rotation = glm::quat{transform.rotation[3], transform.rotation[0], transform.rotation[1], transform.rotation[2]};
+                description.Scale = glm::vec3{transform.scale[0], transform.scale[1], transform.scale[2]};
+            },
+        },
+        node.transform);
+}
+
+std::optional<std::vector<std::shared_ptr<MeshAsset>>> loadGltfMeshes(class VulkanEngine *engine, std::filesystem::path filePath) {
+    std::optional<fastgltf::Asset> gltf = parseGltf(filePath);
+    if (!gltf.has_value()) return std::nullopt;
+
+    return loadMeshes(engine, gltf.value());
+}
+
+std::optional<LoadedScene> loadGltfScene(class VulkanEngine *engine, std::filesystem::path filePath) {
+    std::optional<fastgltf::Asset> gltf = parseGltf(filePath);
+    if (!gltf.has_value()) return std::nullopt;
+
+    LoadedScene scene{};
+    scene.Meshes = loadMeshes(engine, gltf.value());
+    scene.Textures = loadImages(engine, gltf.value(), filePath.parent_path());
+    scene.Samplers = loadSamplers(engine, gltf.value());
+
+    std::vector<std::size_t> roots{};
+    if (!gltf->scenes.empty()) {
+        const fastgltf::Scene &gltfScene = gltf->scenes[gltf->defaultScene.has_value() ? gltf->defaultScene.value() : 0];
+        roots.assign(gltfScene.nodeIndices.begin(), gltfScene.nodeIndices.end());
+    } else {
+        std::vector<bool> isChild(gltf->nodes.size(), false);
+        for (const fastgltf::Node &node : gltf->nodes) {
+            for (std::size_t child : node.children) {
+                isChild[child] = true;
+            }
+        }
+        for (std::size_t i = 0; i < gltf->nodes.size(); i++) {
+            if (!isChild[i]) roots.emplace_back(i);
+        }
+    }
+
+    std::deque<std::pair<std::size_t, std::uint32_t>> pending{};
+    for (std::size_t root : roots) {
+        pending.emplace_back(root, SCENE_NO_PARENT);
+    }
+
+    while (!pending.empty()) {
+        auto [nodeIndex, parent] = pending.front();
+        pending.pop_front();
+
+        const fastgltf::Node &node = gltf->nodes[nodeIndex];
+
+        SceneGraph::NodeDescription description{
+            .Name = node.name,
+            .Parent = parent,
+            .MeshIndex = node.meshIndex.has_value() ? (std::int32_t)node.meshIndex.value() : SCENE_NO_MESH,
+        };
+        getNodeTransform(node, description);
+
+        const std::uint32_t sceneNode = scene.Graph.addNode(description);
+        for (std::size_t child : node.children) {
+            pending.emplace_back(child, sceneNode);
+        }
+    }
+
+    scene.Graph.finalize();
+
+    std::cout << "Loaded scene: " << filePath << " (" << scene.Graph.getNodeCount() << " nodes, " << scene.Graph.getLevelCount() << " levels)" << std::endl;
+
+    return scene;
 }
\ No newline at end of file
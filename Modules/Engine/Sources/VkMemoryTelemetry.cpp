@@ -0,0 +1,124 @@
+#include <VkGuide/VkMemoryTelemetry.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+namespace vkutils {
+    const char *GetMemoryCategoryName(MemoryCategory category) {
+        switch (category) {
+            case MemoryCategory::Mesh:
+                return "Mesh";
+            case MemoryCategory::Texture:
+                return "Texture";
+            case MemoryCategory::RenderTarget:
+                return "RenderTarget";
+            case MemoryCategory::Staging:
+                return "Staging";
+            case MemoryCategory::Frame:
+                return "Frame";
+            default:
+                return "Unknown";
+        }
+    }
+}  // namespace vkutils
+
+void MemoryTelemetry::init(VmaAllocator allocator, bool memoryBudget) {
+    m_Allocator = allocator;
+    m_MemoryBudget = memoryBudget;
+}
+
+void MemoryTelemetry::destroy() {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    for (std::size_t i = 0; i < MEMORY_CATEGORY_COUNT; i++) {
+        const MemoryCategoryStats &stats = m_Categories[i];
+        if (stats.AllocationCount == 0) continue;
+
+        fmt::println("[ERROR]: {} {} allocations ({} bytes) were not destroyed.", stats.AllocationCount, vkutils::GetMemoryCategoryName((MemoryCategory)i), stats.AllocationBytes);
+    }
+    m_Categories = {};
+}
+
+void MemoryTelemetry::track(VmaAllocation allocation, MemoryCategory category) {
+    VmaAllocationInfo allocationInfo{};
+    vmaGetAllocationInfo(m_Allocator, allocation, &allocationInfo);
+
+    vmaSetAllocationUserData(m_Allocator, allocation, (void *)((std::uintptr_t)category + 1));
+    vmaSetAllocationName(m_Allocator, allocation, vkutils::GetMemoryCategoryName(category));
+
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    MemoryCategoryStats &stats = m_Categories[(std::size_t)category];
+    stats.AllocationCount++;
+    stats.AllocationBytes += allocationInfo.size;
+    stats.PeakBytes = std::max(stats.PeakBytes, stats.AllocationBytes);
+}
+
+void MemoryTelemetry::untrack(VmaAllocation allocation) {
+    if (allocation == nullptr) return;
+
+    VmaAllocationInfo allocationInfo{};
+    vmaGetAllocationInfo(m_Allocator, allocation, &allocationInfo);
+    if (allocationInfo.pUserData == nullptr) return;
+
+    const std::size_t category = (std::uintptr_t)allocationInfo.pUserData - 1;
+    assert(category < MEMORY_CATEGORY_COUNT);
+
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    MemoryCategoryStats &stats = m_Categories[category];
+    stats.AllocationCount--;
+    stats.AllocationBytes -= allocationInfo.size;
+}
+
+std::vector<MemoryHeapStats> MemoryTelemetry::getHeapStats() const {
+    const VkPhysicalDeviceMemoryProperties *memoryProperties = nullptr;
+    vmaGetMemoryProperties(m_Allocator, &memoryProperties);
+
+    std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets{};
+    vmaGetHeapBudgets(m_Allocator, budgets.data());
+
+    std::vector<MemoryHeapStats> heaps{};
+    heaps.reserve(memoryProperties->memoryHeapCount);
+    for (std::uint32_t heap = 0; heap < memoryProperties->memoryHeapCount; heap++) {
+        const VmaBudget &budget = budgets[heap];
+        heaps.emplace_back(MemoryHeapStats{
+            .Flags = memoryProperties->memoryHeaps[heap].flags,
+            .Size = memoryProperties->memoryHeaps[heap].size,
+            .Budget = budget.budget,
+            .Usage = budget.usage,
+            .BlockBytes = budget.statistics.blockBytes,
+            .AllocationBytes = budget.statistics.allocationBytes,
+            .BlockCount = budget.statistics.blockCount,
+            .AllocationCount = budget.statistics.allocationCount,
+        });
+    }
+
+    return heaps;
+}
+
+MemoryCategoryStats MemoryTelemetry::getCategoryStats(MemoryCategory category) const {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    return m_Categories[(std::size_t)category];
+}
+
+bool MemoryTelemetry::hasMemoryBudget() const {
+    return m_MemoryBudget;
+}
+
+bool MemoryTelemetry::writeStats(const std::filesystem::path &filePath) const {
+    char *statsString = nullptr;
+    vmaBuildStatsString(m_Allocator, &statsString, VK_TRUE);
+
+    std::ofstream file{filePath, std::ios::trunc};
+    if (file.is_open()) {
+        file << statsString;
+        file.close();
+    }
+    vmaFreeStatsString(m_Allocator, statsString);
+
+    if (!file) {
+        fmt::println("[ERROR]: Failed to write memory stats: {}.", filePath.string());
+        return false;
+    }
+
+    fmt::println("[INFO]: Wrote memory stats to {}.", filePath.string());
+    return true;
+}
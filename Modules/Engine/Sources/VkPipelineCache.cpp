@@ -0,0 +1,174 @@
+#include <VkGuide/VkPipelineCache.hpp>
+
+#include <cstring>
+#include <fstream>
+
+constexpr std::uint32_t PIPELINE_CACHE_FILE_MAGIC{0x43505356};  // "VSPC"
+constexpr std::uint32_t PIPELINE_CACHE_FILE_VERSION{1};
+
+struct PipelineCacheFileHeader {
+    std::uint32_t Magic;
+    std::uint32_t Version;
+    std::uint64_t DataSize;
+    double ColdCreationTime;
+};
+
+void PipelineCache::init(VkDevice device, VkPhysicalDevice physicalDevice, const std::filesystem::path &directory) {
+    assert(m_Cache == VK_NULL_HANDLE);
+
+    m_Device = device;
+
+    VkPhysicalDeviceIDProperties idProperties{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES,
+    };
+    VkPhysicalDeviceProperties2 properties{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+        .pNext = &idProperties,
+    };
+    vkGetPhysicalDeviceProperties2(physicalDevice, &properties);
+    m_Properties = properties.properties;
+
+    std::string driverUUID{};
+    for (std::uint8_t byte : idProperties.driverUUID) {
+        driverUUID += fmt::format("{:02x}", byte);
+    }
+
+    m_FilePath = directory / fmt::format("PipelineCache_{:04x}_{:04x}_{}.bin", m_Properties.vendorID, m_Properties.deviceID, driverUUID);
+
+    std::vector<char> initialData{};
+    m_IsWarm = load(initialData);
+
+    VkPipelineCacheCreateInfo info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        .initialDataSize = m_IsWarm ? initialData.size() : 0,
+        .pInitialData = m_IsWarm ? initialData.data() : nullptr,
+    };
+
+    VkResult result = vkCreatePipelineCache(m_Device, &info, nullptr, &m_Cache);
+    if (result != VK_SUCCESS && m_IsWarm) {
+        fmt::println("[WARNING]: Driver rejected pipeline cache {}: {}.", m_FilePath.string(), string_VkResult(result));
+        m_IsWarm = false;
+        info.initialDataSize = 0;
+        info.pInitialData = nullptr;
+        result = vkCreatePipelineCache(m_Device, &info, nullptr, &m_Cache);
+    }
+    VK_CHECK(result);
+}
+
+void PipelineCache::save() {
+    assert(m_Cache != VK_NULL_HANDLE);
+
+    std::size_t dataSize{0};
+    VK_CHECK(vkGetPipelineCacheData(m_Device, m_Cache, &dataSize, nullptr));
+
+    std::vector<char> data(dataSize);
+    VK_CHECK(vkGetPipelineCacheData(m_Device, m_Cache, &dataSize, data.data()));
+
+    PipelineCacheFileHeader header{
+        .Magic = PIPELINE_CACHE_FILE_MAGIC,
+        .Version = PIPELINE_CACHE_FILE_VERSION,
+        .DataSize = dataSize,
+        .ColdCreationTime = m_ColdCreationTime,
+    };
+
+    std::error_code error{};
+    std::filesystem::create_directories(m_FilePath.parent_path(), error);
+
+    std::filesystem::path temporaryPath{m_FilePath};
+    temporaryPath += ".tmp";
+
+    std::ofstream file{temporaryPath, std::ios::binary | std::ios::trunc};
+    if (!file.is_open()) {
+        fmt::println("[ERROR]: Failed to open pipeline cache file for writing: {}.", temporaryPath.string());
+        return;
+    }
+
+    file.write((const char *)&header, sizeof(header));
+    file.write(data.data(), dataSize);
+    file.flush();
+    file.close();
+
+    if (!file) {
+        fmt::println("[ERROR]: Failed to write pipeline cache file: {}.", temporaryPath.string());
+        std::filesystem::remove(temporaryPath, error);
+        return;
+    }
+
+    std::filesystem::rename(temporaryPath, m_FilePath, error);
+    if (error) {
+        fmt::println("[ERROR]: Failed to replace pipeline cache file {}: {}.", m_FilePath.string(), error.message());
+        std::filesystem::remove(temporaryPath, error);
+        return;
+    }
+
+    fmt::println("[INFO]: Saved pipeline cache ({} bytes) to {}.", dataSize, m_FilePath.string());
+}
+
+void PipelineCache::destroy() {
+    assert(m_Cache != VK_NULL_HANDLE);
+    vkDestroyPipelineCache(m_Device, m_Cache, nullptr);
+    m_Cache = VK_NULL_HANDLE;
+}
+
+void PipelineCache::recordCreationTime(double milliseconds) {
+    if (!m_IsWarm) {
+        m_ColdCreationTime = milliseconds;
+        fmt::println("[INFO]: Created pipelines in {:.2f} ms with a cold pipeline cache.", milliseconds);
+        return;
+    }
+
+    fmt::println("[INFO]: Created pipelines in {:.2f} ms with a warm pipeline cache (cold: {:.2f} ms, saved {:.2f} ms).", milliseconds, m_ColdCreationTime, m_ColdCreationTime - milliseconds);
+}
+
+VkPipelineCache PipelineCache::get() const {
+    return m_Cache;
+}
+
+bool PipelineCache::isWarm() const {
+    return m_IsWarm;
+}
+
+bool PipelineCache::load(std::vector<char> &outData) {
+    std::ifstream file{m_FilePath, std::ios::ate | std::ios::binary};
+    if (!file.is_open()) return false;
+
+    const std::size_t fileSize = file.tellg();
+    if (fileSize < sizeof(PipelineCacheFileHeader)) return false;
+
+    PipelineCacheFileHeader header{};
+    file.seekg(0);
+    file.read((char *)&header, sizeof(header));
+
+    if (header.Magic != PIPELINE_CACHE_FILE_MAGIC ||
+        header.Version != PIPELINE_CACHE_FILE_VERSION ||
+        header.DataSize != fileSize - sizeof(PipelineCacheFileHeader)) {
+        fmt::println("[WARNING]: Ignoring malformed pipeline cache file: {}.", m_FilePath.string());
+        return false;
+    }
+
+    outData.resize(header.DataSize);
+    file.read(outData.data(), header.DataSize);
+    if (!file.good()) return false;
+
+    if (!isCompatible(outData)) {
+        fmt::println("[WARNING]: Ignoring pipeline cache from a different device or driver: {}.", m_FilePath.string());
+        return false;
+    }
+
+    m_ColdCreationTime = header.ColdCreationTime;
+    return true;
+}
+
+bool PipelineCache::isCompatible(const std::vector<char> &data) const {
+    if (data.size() < sizeof(VkPipelineCacheHeaderVersionOne)) return false;
+
+    VkPipelineCacheHeaderVersionOne header{};
+    memcpy(&header, data.data(), sizeof(header));
+
+    return header.headerSize >= sizeof(VkPipelineCacheHeaderVersionOne) &&
+           header.headerSize <= data.size() &&
+           header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == m_Properties.vendorID &&
+           header.deviceID == m_Properties.deviceID &&
+           memcmp(header.pipelineCacheUUID, m_Properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
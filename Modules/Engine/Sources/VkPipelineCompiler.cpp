@@ -0,0 +1,120 @@
+#include <VkGuide/VkPipelineCompiler.hpp>
+#include <VkGuide/VkJobs.hpp>
+#include <VkGuide/VkPipelineLibrary.hpp>
+
+#include <chrono>
+
+PipelineHandle::PipelineHandle(std::shared_future<VkPipeline> future)
+    : m_Future{std::move(future)} {}
+
+bool PipelineHandle::isValid() const {
+    return m_Future.valid();
+}
+
+bool PipelineHandle::isReady() const {
+    return m_Future.valid() && m_Future.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+}
+
+VkPipeline PipelineHandle::get() const {
+    assert(m_Future.valid());
+    return m_Future.get();
+}
+
+void PipelineCompiler::init(VkDevice device, VkPipelineCache pipelineCache, JobSystem *jobSystem) {
+    m_Device = device;
+    m_PipelineCache = pipelineCache;
+    m_JobSystem = jobSystem;
+    m_JobGroup = jobSystem->createGroup();
+}
+
+PipelineHandle PipelineCompiler::compile(const PipelineBuilder &builder, VkPipelineLayout layout, VkPipeline *outPipeline) {
+    assert(m_JobSystem != nullptr);
+
+    return track(m_JobSystem->submit([this, builder, layout, outPipeline]() {
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+        VkPipeline pipeline = builder.build(m_Device, layout, m_PipelineCache);
+        if (outPipeline != nullptr) *outPipeline = pipeline;
+
+        m_CompileCount++;
+        m_CompileMicroseconds += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+        return pipeline;
+    }, m_JobGroup));
+}
+
+PipelineHandle PipelineCompiler::link(const PipelineBuilder &builder, VkPipelineLayout layout, PipelineLibraryLinker *linker, VkPipeline *outPipeline) {
+    assert(m_JobSystem != nullptr && linker != nullptr);
+
+    return track(m_JobSystem->submit([builder, layout, linker, outPipeline]() {
+        VkPipeline pipeline = linker->link(builder, layout, false);
+        if (outPipeline != nullptr) *outPipeline = pipeline;
+        return pipeline;
+    }, m_JobGroup));
+}
+
+PipelineHandle PipelineCompiler::optimize(const PipelineBuilder &builder, VkPipelineLayout layout, PipelineLibraryLinker *linker) {
+    assert(m_JobSystem != nullptr && linker != nullptr);
+
+    std::future<VkPipeline> future = m_JobSystem->submit([builder, layout, linker]() {
+        return linker->link(builder, layout, true);
+    });
+    return PipelineHandle{future.share()};
+}
+
+PipelineHandle PipelineCompiler::compileCompute(const VkComputePipelineCreateInfo &info, VkPipeline *outPipeline) {
+    assert(m_JobSystem != nullptr);
+    assert(info.pNext == nullptr && info.stage.pNext == nullptr && info.stage.pSpecializationInfo == nullptr);
+
+    return track(m_JobSystem->submit([device = m_Device, pipelineCache = m_PipelineCache, info, outPipeline]() {
+        VkPipeline pipeline{VK_NULL_HANDLE};
+        VK_CHECK(vkCreateComputePipelines(device, pipelineCache, 1, &info, nullptr, &pipeline));
+        if (outPipeline != nullptr) *outPipeline = pipeline;
+        return pipeline;
+    }, m_JobGroup));
+}
+
+void PipelineCompiler::destroyShaderModuleWhenIdle(VkShaderModule shaderModule) {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    m_PendingShaderModules.emplace_back(shaderModule);
+}
+
+void PipelineCompiler::waitIdle() {
+    std::vector<std::shared_future<VkPipeline>> pending{};
+    std::vector<VkShaderModule> shaderModules{};
+    {
+        std::lock_guard<std::mutex> lock{m_Mutex};
+        pending.swap(m_Pending);
+        shaderModules.swap(m_PendingShaderModules);
+    }
+
+    for (const std::shared_future<VkPipeline> &future : pending) {
+        while (future.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+            if (!m_JobSystem->runPendingJob(m_JobGroup)) {
+                future.wait();
+            }
+        }
+    }
+
+    for (VkShaderModule shaderModule : shaderModules) {
+        vkDestroyShaderModule(m_Device, shaderModule, nullptr);
+    }
+}
+
+std::uint32_t PipelineCompiler::getSubmittedCount() const {
+    return m_SubmittedCount;
+}
+
+double PipelineCompiler::getAverageCompileTime() const {
+    const std::uint32_t count = m_CompileCount;
+    return count > 0 ? (double)m_CompileMicroseconds / count / 1000.0 : 0.0;
+}
+
+PipelineHandle PipelineCompiler::track(std::future<VkPipeline> &&future) {
+    std::shared_future<VkPipeline> shared = future.share();
+
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    m_Pending.emplace_back(shared);
+    m_SubmittedCount++;
+
+    return PipelineHandle{shared};
+}
@@ -0,0 +1,157 @@
+#include <VkGuide/VkPipelineLibrary.hpp>
+
+#include <chrono>
+
+constexpr std::array<VkGraphicsPipelineLibraryFlagBitsEXT, 4> LIBRARY_PARTS{
+    VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT,
+    VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+    VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT,
+    VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT,
+};
+
+static PipelineStateKey GetLibraryKey(const PipelineStateKey &key, VkGraphicsPipelineLibraryFlagBitsEXT part) {
+    PipelineStateKey libraryKey{.DynamicState = key.DynamicState};
+
+    switch (part) {
+        case VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT:
+            libraryKey.Topology = key.Topology;
+            break;
+        case VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT:
+            libraryKey.VertexShader = key.VertexShader;
+            libraryKey.Layout = key.Layout;
+            libraryKey.PolygonMode = key.PolygonMode;
+            libraryKey.CullMode = key.CullMode;
+            libraryKey.FrontFace = key.FrontFace;
+            break;
+        case VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT:
+            libraryKey.FragmentShader = key.FragmentShader;
+            libraryKey.Layout = key.Layout;
+            libraryKey.DepthTestEnable = key.DepthTestEnable;
+            libraryKey.DepthWriteEnable = key.DepthWriteEnable;
+            libraryKey.DepthCompareOp = key.DepthCompareOp;
+            libraryKey.RasterizationSamples = key.RasterizationSamples;
+            libraryKey.ColorAttachmentFormat = key.ColorAttachmentFormat;
+            libraryKey.DepthAttachmentFormat = key.DepthAttachmentFormat;
+            break;
+        case VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT:
+            libraryKey.BlendEnable = key.BlendEnable;
+            libraryKey.SrcColorBlendFactor = key.SrcColorBlendFactor;
+            libraryKey.DstColorBlendFactor = key.DstColorBlendFactor;
+            libraryKey.ColorBlendOp = key.ColorBlendOp;
+            libraryKey.SrcAlphaBlendFactor = key.SrcAlphaBlendFactor;
+            libraryKey.DstAlphaBlendFactor = key.DstAlphaBlendFactor;
+            libraryKey.AlphaBlendOp = key.AlphaBlendOp;
+            libraryKey.ColorWriteMask = key.ColorWriteMask;
+            libraryKey.RasterizationSamples = key.RasterizationSamples;
+            libraryKey.ColorAttachmentFormat = key.ColorAttachmentFormat;
+            libraryKey.DepthAttachmentFormat = key.DepthAttachmentFormat;
+            break;
+        default:
+            assert(false);
+    }
+
+    return libraryKey;
+}
+
+void PipelineLibraryLinker::init(VkDevice device, VkPipelineCache pipelineCache, bool isSupported, bool hasFastLinking) {
+    m_Device = device;
+    m_PipelineCache = pipelineCache;
+    m_IsSupported = isSupported;
+    m_HasFastLinking = isSupported && hasFastLinking;
+}
+
+void PipelineLibraryLinker::destroy() {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    for (std::unordered_map<PipelineStateKey, VkPipeline, PipelineStateKeyHash> &libraries : m_Libraries) {
+        for (const auto &[key, library] : libraries) {
+            vkDestroyPipeline(m_Device, library, nullptr);
+        }
+        libraries.clear();
+    }
+}
+
+bool PipelineLibraryLinker::isSupported() const {
+    return m_IsSupported;
+}
+
+bool PipelineLibraryLinker::hasFastLinking() const {
+    return m_HasFastLinking;
+}
+
+VkPipeline PipelineLibraryLinker::link(const PipelineBuilder &builder, VkPipelineLayout layout, bool optimize) {
+    assert(m_IsSupported);
+
+    std::array<VkPipeline, LIBRARY_PARTS.size()> libraries{};
+    for (std::uint32_t i = 0; i < LIBRARY_PARTS.size(); i++) {
+        libraries[i] = getLibrary(builder, layout, i);
+    }
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+    VkPipelineLibraryCreateInfoKHR libraryInfo{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR,
+        .libraryCount = (std::uint32_t)libraries.size(),
+        .pLibraries = libraries.data(),
+    };
+
+    VkGraphicsPipelineCreateInfo pipelineInfo{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pNext = &libraryInfo,
+        .flags = optimize ? (VkPipelineCreateFlags)VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT : 0,
+        .layout = layout,
+    };
+
+    VkPipeline pipeline{VK_NULL_HANDLE};
+    VK_CHECK(vkCreateGraphicsPipelines(m_Device, m_PipelineCache, 1, &pipelineInfo, nullptr, &pipeline));
+
+    const std::uint64_t elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+    if (optimize) {
+        m_OptimizedLinkCount++;
+        m_OptimizedLinkMicroseconds += elapsed;
+    } else {
+        m_LinkCount++;
+        m_LinkMicroseconds += elapsed;
+    }
+
+    return pipeline;
+}
+
+std::uint32_t PipelineLibraryLinker::getLibraryCount() const {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+
+    std::uint32_t count = 0;
+    for (const std::unordered_map<PipelineStateKey, VkPipeline, PipelineStateKeyHash> &libraries : m_Libraries) {
+        count += (std::uint32_t)libraries.size();
+    }
+    return count;
+}
+
+double PipelineLibraryLinker::getAverageLinkTime() const {
+    const std::uint32_t count = m_LinkCount;
+    return count > 0 ? (double)m_LinkMicroseconds / count / 1000.0 : 0.0;
+}
+
+double PipelineLibraryLinker::getAverageOptimizedLinkTime() const {
+    const std::uint32_t count = m_OptimizedLinkCount;
+    return count > 0 ? (double)m_OptimizedLinkMicroseconds / count / 1000.0 : 0.0;
+}
+
+VkPipeline PipelineLibraryLinker::getLibrary(const PipelineBuilder &builder, VkPipelineLayout layout, std::uint32_t part) {
+    const PipelineStateKey key = GetLibraryKey(builder.getStateKey(layout), LIBRARY_PARTS[part]);
+    std::unordered_map<PipelineStateKey, VkPipeline, PipelineStateKeyHash> &libraries = m_Libraries[part];
+
+    {
+        std::lock_guard<std::mutex> lock{m_Mutex};
+        std::unordered_map<PipelineStateKey, VkPipeline, PipelineStateKeyHash>::const_iterator it = libraries.find(key);
+        if (it != libraries.end()) return it->second;
+    }
+
+    VkPipeline library = builder.buildLibrary(m_Device, layout, m_PipelineCache, LIBRARY_PARTS[part]);
+
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    auto [it, inserted] = libraries.emplace(key, library);
+    if (!inserted) {
+        vkDestroyPipeline(m_Device, library, nullptr);
+    }
+    return it->second;
+}
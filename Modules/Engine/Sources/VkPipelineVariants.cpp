@@ -0,0 +1,124 @@
+#include <VkGuide/VkPipelineVariants.hpp>
+
+static PipelineHandle GetReadyHandle(VkPipeline pipeline) {
+    std::promise<VkPipeline> promise{};
+    promise.set_value(pipeline);
+    return PipelineHandle{promise.get_future().share()};
+}
+
+void PipelineVariantCache::init(VkDevice device, PipelineCompiler *compiler, PipelineLibraryLinker *linker) {
+    m_Device = device;
+    m_Compiler = compiler;
+    m_Linker = linker;
+}
+
+void PipelineVariantCache::destroy() {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    for (const auto &[key, variant] : m_Variants) {
+        vkDestroyPipeline(m_Device, variant.Pipeline.get(), nullptr);
+        if (variant.OptimizedPipeline.isValid()) {
+            vkDestroyPipeline(m_Device, variant.OptimizedPipeline.get(), nullptr);
+        }
+    }
+    for (const PipelineHandle &handle : m_DiscardedPipelines) {
+        vkDestroyPipeline(m_Device, handle.get(), nullptr);
+    }
+    m_Variants.clear();
+    m_DiscardedPipelines.clear();
+    m_PendingOptimizations = 0;
+}
+
+PipelineHandle PipelineVariantCache::getPipeline(const PipelineBuilder &builder, VkPipelineLayout layout, VkPipeline *outPipeline) {
+    assert(m_Compiler != nullptr);
+
+    const PipelineStateKey key = builder.getStateKey(layout);
+
+    PipelineHandle handle{};
+    {
+        std::lock_guard<std::mutex> lock{m_Mutex};
+
+        std::unordered_map<PipelineStateKey, Variant, PipelineStateKeyHash>::const_iterator it = m_Variants.find(key);
+        if (it == m_Variants.end()) {
+            m_MissCount++;
+
+            Variant variant{};
+            if (m_Linker != nullptr && m_Linker->hasFastLinking()) {
+                variant.Pipeline = m_Compiler->link(builder, layout, m_Linker, outPipeline);
+                variant.OptimizedPipeline = m_Compiler->optimize(builder, layout, m_Linker);
+                m_PendingOptimizations++;
+            } else {
+                variant.Pipeline = m_Compiler->compile(builder, layout, outPipeline);
+            }
+
+            m_Variants.emplace(key, variant);
+            return variant.Pipeline;
+        }
+
+        m_HitCount++;
+        handle = it->second.Pipeline;
+    }
+
+    if (outPipeline != nullptr) *outPipeline = handle.get();
+    return handle;
+}
+
+bool PipelineVariantCache::replace(VkPipeline oldPipeline, VkPipeline newPipeline) {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+
+    for (auto &[key, variant] : m_Variants) {
+        if (!variant.Pipeline.isReady() || variant.Pipeline.get() != oldPipeline) continue;
+
+        if (variant.OptimizedPipeline.isValid()) {
+            m_DiscardedPipelines.emplace_back(variant.OptimizedPipeline);
+            variant.OptimizedPipeline = PipelineHandle{};
+            m_PendingOptimizations--;
+        }
+
+        variant.Pipeline = GetReadyHandle(newPipeline);
+        return true;
+    }
+    return false;
+}
+
+std::vector<std::pair<VkPipeline, VkPipeline>> PipelineVariantCache::applyOptimizedPipelines() {
+    std::vector<std::pair<VkPipeline, VkPipeline>> optimized{};
+
+    std::lock_guard<std::mutex> lock{m_Mutex};
+
+    for (std::vector<PipelineHandle>::iterator it = m_DiscardedPipelines.begin(); it != m_DiscardedPipelines.end();) {
+        if (it->isReady()) {
+            vkDestroyPipeline(m_Device, it->get(), nullptr);
+            it = m_DiscardedPipelines.erase(it);
+        } else {
+            it++;
+        }
+    }
+
+    if (m_PendingOptimizations == 0) return optimized;
+
+    for (auto &[key, variant] : m_Variants) {
+        if (!variant.OptimizedPipeline.isReady() || !variant.Pipeline.isReady()) continue;
+
+        optimized.emplace_back(variant.Pipeline.get(), variant.OptimizedPipeline.get());
+        variant.Pipeline = variant.OptimizedPipeline;
+        variant.OptimizedPipeline = PipelineHandle{};
+        m_PendingOptimizations--;
+    }
+
+    return optimized;
+}
+
+std::uint32_t PipelineVariantCache::getVariantCount() const {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    return (std::uint32_t)m_Variants.size();
+}
+
+std::uint32_t PipelineVariantCache::getHitCount() const {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    return m_HitCount;
+}
+
+std::uint32_t PipelineVariantCache::getMissCount() const {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    return m_MissCount;
+}
@@ -13,7 +13,7 @@ namespace vkutils {
         std::size_t fileSize = file.tellg();
 
         std::vector<std::uint32_t> buffer{};
-        buffer.reserve(fileSize / sizeof(std::uint32_t));
+        buffer.resize((fileSize + sizeof(std::uint32_t) - 1) / sizeof(std::uint32_t));
 
         file.seekg(0);
         file.read((char*)buffer.data(), fileSize);
@@ -30,8 +30,55 @@ namespace vkutils {
         }
         return true;
     }
+
+    VkPrimitiveTopology GetTopologyClass(VkPrimitiveTopology topology) {
+        switch (topology) {
+            case VK_PRIMITIVE_TOPOLOGY_POINT_LIST:
+                return VK_PRIMITIVE_TOPOLOGY_POINT_LIST;
+            case VK_PRIMITIVE_TOPOLOGY_LINE_LIST:
+            case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP:
+            case VK_PRIMITIVE_TOPOLOGY_LINE_LIST_WITH_ADJACENCY:
+            case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY:
+                return VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
+            case VK_PRIMITIVE_TOPOLOGY_PATCH_LIST:
+                return VK_PRIMITIVE_TOPOLOGY_PATCH_LIST;
+            default:
+                return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        }
+    }
 }  // namespace vkutils
 
+std::size_t PipelineStateKeyHash::operator()(const PipelineStateKey &key) const {
+    std::size_t hash = 0;
+    auto combine = [&hash](std::size_t value) {
+        hash ^= value + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+    };
+
+    combine(std::hash<VkShaderModule>{}(key.VertexShader));
+    combine(std::hash<VkShaderModule>{}(key.FragmentShader));
+    combine(std::hash<VkPipelineLayout>{}(key.Layout));
+    combine(key.Topology);
+    combine(key.PolygonMode);
+    combine(key.CullMode);
+    combine(key.FrontFace);
+    combine(key.BlendEnable);
+    combine(key.SrcColorBlendFactor);
+    combine(key.DstColorBlendFactor);
+    combine(key.ColorBlendOp);
+    combine(key.SrcAlphaBlendFactor);
+    combine(key.DstAlphaBlendFactor);
+    combine(key.AlphaBlendOp);
+    combine(key.ColorWriteMask);
+    combine(key.DepthTestEnable);
+    combine(key.DepthWriteEnable);
+    combine(key.DepthCompareOp);
+    combine(key.RasterizationSamples);
+    combine(key.ColorAttachmentFormat);
+    combine(key.DepthAttachmentFormat);
+    combine(key.DynamicState);
+    return hash;
+}
+
 PipelineBuilder::PipelineBuilder() {
     clear();
 }
@@ -130,6 +177,10 @@ void PipelineBuilder::setDepthTestDisabled() {
     m_DepthStencil.maxDepthBounds = 1.0f;
 }
 
+void PipelineBuilder::setDynamicState(DynamicStateFlags flags) {
+    m_DynamicState = flags;
+}
+
 void PipelineBuilder::clear() {
     m_InputAssembly = VkPipelineInputAssemblyStateCreateInfo{
         .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
@@ -149,9 +200,108 @@ void PipelineBuilder::clear() {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
     };
     m_ShaderStages.clear();
+    m_DynamicState = 0;
+}
+
+PipelineStateKey PipelineBuilder::getStateKey(VkPipelineLayout layout) const {
+    PipelineStateKey key{
+        .VertexShader = VK_NULL_HANDLE,
+        .FragmentShader = VK_NULL_HANDLE,
+        .Layout = layout,
+        .Topology = m_InputAssembly.topology,
+        .PolygonMode = m_Rasterization.polygonMode,
+        .CullMode = m_Rasterization.cullMode,
+        .FrontFace = m_Rasterization.frontFace,
+        .BlendEnable = m_ColorBlendAttachment.blendEnable,
+        .SrcColorBlendFactor = VK_BLEND_FACTOR_ZERO,
+        .DstColorBlendFactor = VK_BLEND_FACTOR_ZERO,
+        .ColorBlendOp = VK_BLEND_OP_ADD,
+        .SrcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO,
+        .DstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO,
+        .AlphaBlendOp = VK_BLEND_OP_ADD,
+        .ColorWriteMask = m_ColorBlendAttachment.colorWriteMask,
+        .DepthTestEnable = m_DepthStencil.depthTestEnable,
+        .DepthWriteEnable = m_DepthStencil.depthWriteEnable,
+        .DepthCompareOp = m_DepthStencil.depthTestEnable ? m_DepthStencil.depthCompareOp : VK_COMPARE_OP_NEVER,
+        .RasterizationSamples = m_Multisampling.rasterizationSamples,
+        .ColorAttachmentFormat = m_RenderInfo.colorAttachmentCount > 0 ? m_ColorAttachmentFormat : VK_FORMAT_UNDEFINED,
+        .DepthAttachmentFormat = m_RenderInfo.depthAttachmentFormat,
+        .DynamicState = m_DynamicState,
+    };
+
+    if (m_ColorBlendAttachment.blendEnable) {
+        key.SrcColorBlendFactor = m_ColorBlendAttachment.srcColorBlendFactor;
+        key.DstColorBlendFactor = m_ColorBlendAttachment.dstColorBlendFactor;
+        key.ColorBlendOp = m_ColorBlendAttachment.colorBlendOp;
+        key.SrcAlphaBlendFactor = m_ColorBlendAttachment.srcAlphaBlendFactor;
+        key.DstAlphaBlendFactor = m_ColorBlendAttachment.dstAlphaBlendFactor;
+        key.AlphaBlendOp = m_ColorBlendAttachment.alphaBlendOp;
+    }
+
+    if (m_DynamicState & DYNAMIC_STATE_RASTERIZATION) {
+        key.CullMode = VK_CULL_MODE_NONE;
+        key.FrontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+        key.Topology = vkutils::GetTopologyClass(key.Topology);
+    }
+
+    if (m_DynamicState & DYNAMIC_STATE_DEPTH) {
+        key.DepthTestEnable = VK_FALSE;
+        key.DepthWriteEnable = VK_FALSE;
+        key.DepthCompareOp = VK_COMPARE_OP_NEVER;
+    }
+
+    if (m_DynamicState & DYNAMIC_STATE_BLEND) {
+        key.BlendEnable = VK_FALSE;
+        key.SrcColorBlendFactor = VK_BLEND_FACTOR_ZERO;
+        key.DstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
+        key.ColorBlendOp = VK_BLEND_OP_ADD;
+        key.SrcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+        key.DstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+        key.AlphaBlendOp = VK_BLEND_OP_ADD;
+        key.ColorWriteMask = 0;
+    }
+
+    for (const VkPipelineShaderStageCreateInfo &stage : m_ShaderStages) {
+        if (stage.stage == VK_SHADER_STAGE_VERTEX_BIT) key.VertexShader = stage.module;
+        if (stage.stage == VK_SHADER_STAGE_FRAGMENT_BIT) key.FragmentShader = stage.module;
+    }
+
+    return key;
+}
+
+PipelineDynamicState PipelineBuilder::getDynamicState() const {
+    return PipelineDynamicState{
+        .CullMode = m_Rasterization.cullMode,
+        .FrontFace = m_Rasterization.frontFace,
+        .Topology = m_InputAssembly.topology,
+        .DepthTestEnable = m_DepthStencil.depthTestEnable,
+        .DepthWriteEnable = m_DepthStencil.depthWriteEnable,
+        .DepthCompareOp = m_DepthStencil.depthCompareOp,
+        .BlendEnable = m_ColorBlendAttachment.blendEnable,
+        .BlendEquation = VkColorBlendEquationEXT{
+            .srcColorBlendFactor = m_ColorBlendAttachment.srcColorBlendFactor,
+            .dstColorBlendFactor = m_ColorBlendAttachment.dstColorBlendFactor,
+            .colorBlendOp = m_ColorBlendAttachment.colorBlendOp,
+            .srcAlphaBlendFactor = m_ColorBlendAttachment.srcAlphaBlendFactor,
+            .dstAlphaBlendFactor = m_ColorBlendAttachment.dstAlphaBlendFactor,
+            .alphaBlendOp = m_ColorBlendAttachment.alphaBlendOp,
+        },
+        .ColorWriteMask = m_ColorBlendAttachment.colorWriteMask,
+    };
 }
 
-VkPipeline PipelineBuilder::build(VkDevice device, VkPipelineLayout layout) {
+VkPipeline PipelineBuilder::build(VkDevice device, VkPipelineLayout layout, VkPipelineCache pipelineCache) const {
+    return create(device, layout, pipelineCache, 0, 0);
+}
+
+VkPipeline PipelineBuilder::buildLibrary(VkDevice device, VkPipelineLayout layout, VkPipelineCache pipelineCache, VkGraphicsPipelineLibraryFlagsEXT libraryFlags) const {
+    assert(libraryFlags != 0);
+
+    const VkPipelineCreateFlags flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR | VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT;
+    return create(device, layout, pipelineCache, flags, libraryFlags);
+}
+
+VkPipeline PipelineBuilder::create(VkDevice device, VkPipelineLayout layout, VkPipelineCache pipelineCache, VkPipelineCreateFlags flags, VkGraphicsPipelineLibraryFlagsEXT libraryFlags) const {
     assert(m_ColorAttachmentFormat != VK_FORMAT_UNDEFINED);
 
     VkPipelineViewportStateCreateInfo viewportState{
@@ -172,17 +322,30 @@ VkPipeline PipelineBuilder::build(VkDevice device, VkPipelineLayout layout) {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
     };
 
-    VkDynamicState dynamicStates[]{VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    std::vector<VkDynamicState> dynamicStates{VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    if (m_DynamicState & DYNAMIC_STATE_RASTERIZATION) {
+        dynamicStates.insert(dynamicStates.end(), {VK_DYNAMIC_STATE_CULL_MODE, VK_DYNAMIC_STATE_FRONT_FACE, VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY});
+    }
+    if (m_DynamicState & DYNAMIC_STATE_DEPTH) {
+        dynamicStates.insert(dynamicStates.end(), {VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE, VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE, VK_DYNAMIC_STATE_DEPTH_COMPARE_OP});
+    }
+    if (m_DynamicState & DYNAMIC_STATE_BLEND) {
+        dynamicStates.insert(dynamicStates.end(), {VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT, VK_DYNAMIC_STATE_COLOR_BLEND_EQUATION_EXT, VK_DYNAMIC_STATE_COLOR_WRITE_MASK_EXT});
+    }
 
     VkPipelineDynamicStateCreateInfo dynamicInfo{
         .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
-        .dynamicStateCount = sizeof(dynamicStates) / sizeof(VkDynamicState),
-        .pDynamicStates = dynamicStates,
+        .dynamicStateCount = (std::uint32_t)dynamicStates.size(),
+        .pDynamicStates = dynamicStates.data(),
     };
 
+    VkPipelineRenderingCreateInfo renderInfo{m_RenderInfo};
+    renderInfo.pColorAttachmentFormats = renderInfo.colorAttachmentCount > 0 ? &m_ColorAttachmentFormat : nullptr;
+
     VkGraphicsPipelineCreateInfo pipelineInfo{
         .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-        .pNext = &m_RenderInfo,
+        .pNext = &renderInfo,
+        .flags = flags,
         .stageCount = (std::uint32_t)m_ShaderStages.size(),
         .pStages = m_ShaderStages.data(),
         .pVertexInputState = &vertexInputInfo,
@@ -196,7 +359,40 @@ VkPipeline PipelineBuilder::build(VkDevice device, VkPipelineLayout layout) {
         .layout = layout,
     };
 
+    VkGraphicsPipelineLibraryCreateInfoEXT libraryInfo{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
+        .pNext = &renderInfo,
+        .flags = libraryFlags,
+    };
+
+    std::vector<VkPipelineShaderStageCreateInfo> shaderStages{};
+    if (libraryFlags != 0) {
+        const bool vertexInput = libraryFlags & VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT;
+        const bool preRasterization = libraryFlags & VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT;
+        const bool fragmentShader = libraryFlags & VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT;
+        const bool fragmentOutput = libraryFlags & VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT;
+
+        for (const VkPipelineShaderStageCreateInfo &stage : m_ShaderStages) {
+            if ((stage.stage == VK_SHADER_STAGE_VERTEX_BIT && preRasterization) ||
+                (stage.stage == VK_SHADER_STAGE_FRAGMENT_BIT && fragmentShader)) {
+                shaderStages.emplace_back(stage);
+            }
+        }
+
+        pipelineInfo.pNext = &libraryInfo;
+        pipelineInfo.stageCount = (std::uint32_t)shaderStages.size();
+        pipelineInfo.pStages = shaderStages.empty() ? nullptr : shaderStages.data();
+        pipelineInfo.pVertexInputState = vertexInput ? &vertexInputInfo : nullptr;
+        pipelineInfo.pInputAssemblyState = vertexInput ? &m_InputAssembly : nullptr;
+        pipelineInfo.pViewportState = preRasterization ? &viewportState : nullptr;
+        pipelineInfo.pRasterizationState = preRasterization ? &m_Rasterization : nullptr;
+        pipelineInfo.pMultisampleState = fragmentShader || fragmentOutput ? &m_Multisampling : nullptr;
+        pipelineInfo.pDepthStencilState = fragmentShader ? &m_DepthStencil : nullptr;
+        pipelineInfo.pColorBlendState = fragmentOutput ? &colorBlending : nullptr;
+        pipelineInfo.layout = preRasterization || fragmentShader ? layout : VK_NULL_HANDLE;
+    }
+
     VkPipeline pipeline{VK_NULL_HANDLE};
-    VK_CHECK(vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline));
+    VK_CHECK(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &pipeline));
     return pipeline;
 }
\ No newline at end of file
@@ -0,0 +1,505 @@
+#include <VkGuide/VkRenderGraph.hpp>
+#include <VkGuide/VkInits.hpp>
+#include <VkGuide/VkMemoryTelemetry.hpp>
+
+#include <algorithm>
+
+constexpr VkAccessFlags2 WRITE_ACCESS_MASK{
+    VK_ACCESS_2_TRANSFER_WRITE_BIT |
+    VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT |
+    VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+    VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT};
+
+struct UsageInfo {
+    VkPipelineStageFlags2 Stage;
+    VkAccessFlags2 Access;
+    VkImageLayout Layout;
+    VkImageUsageFlags ImageUsage;
+    bool IsRead;
+    bool IsWrite;
+};
+
+static UsageInfo getUsageInfo(RenderGraphUsage usage) {
+    constexpr VkPipelineStageFlags2 fragmentTests = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+
+    switch (usage) {
+        case RenderGraphUsage::TransferRead:
+            return {VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT, true, false};
+        case RenderGraphUsage::TransferWrite:
+            return {VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT, false, true};
+        case RenderGraphUsage::ComputeStorageRead:
+            return {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_USAGE_STORAGE_BIT, true, false};
+        case RenderGraphUsage::ComputeStorageWrite:
+            return {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_USAGE_STORAGE_BIT, false, true};
+        case RenderGraphUsage::ComputeSampled:
+            return {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_SAMPLED_BIT, true, false};
+        case RenderGraphUsage::FragmentSampled:
+            return {VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_SAMPLED_BIT, true, false};
+        case RenderGraphUsage::VertexStorageRead:
+            return {VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_USAGE_STORAGE_BIT, true, false};
+        case RenderGraphUsage::ColorAttachmentWrite:
+            return {VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, false, true};
+        case RenderGraphUsage::ColorAttachmentReadWrite:
+            return {VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, true, true};
+        case RenderGraphUsage::DepthAttachmentWrite:
+            return {fragmentTests, VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, false, true};
+        case RenderGraphUsage::DepthAttachmentRead:
+            return {fragmentTests, VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT, VK_IMAGE_LAYOUT_DEPTH_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, true, false};
+    }
+
+    assert(false);
+    return {};
+}
+
+static VkImageAspectFlags getAspect(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_D16_UNORM:
+        case VK_FORMAT_D32_SFLOAT:
+        case VK_FORMAT_X8_D24_UNORM_PACK32:
+            return VK_IMAGE_ASPECT_DEPTH_BIT;
+        case VK_FORMAT_D16_UNORM_S8_UINT:
+        case VK_FORMAT_D24_UNORM_S8_UINT:
+        case VK_FORMAT_D32_SFLOAT_S8_UINT:
+            return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+        default:
+            return VK_IMAGE_ASPECT_COLOR_BIT;
+    }
+}
+
+RenderGraphPassBuilder::RenderGraphPassBuilder(RenderGraph *graph, std::uint32_t pass) : m_Graph{graph}, m_Pass{pass} {
+}
+
+RenderGraphPassBuilder &RenderGraphPassBuilder::access(std::uint32_t resource, RenderGraphUsage usage) {
+    assert(resource < m_Graph->m_Resources.size());
+    assert(m_Graph->m_Resources[resource].IsImage || usage == RenderGraphUsage::TransferRead || usage == RenderGraphUsage::TransferWrite ||
+           usage == RenderGraphUsage::ComputeStorageRead || usage == RenderGraphUsage::ComputeStorageWrite || usage == RenderGraphUsage::VertexStorageRead);
+
+    m_Graph->m_Passes[m_Pass].Accesses.emplace_back(RenderGraph::ResourceAccess{.Resource = resource, .Usage = usage});
+    return *this;
+}
+
+void RenderGraph::init(VkDevice device, VmaAllocator allocator, MemoryTelemetry *memoryTelemetry, std::uint32_t framesInFlight) {
+    m_Device = device;
+    m_Allocator = allocator;
+    m_MemoryTelemetry = memoryTelemetry;
+    m_FramesInFlight = framesInFlight;
+}
+
+void RenderGraph::destroy() {
+    releaseRetired(~0ULL);
+    destroyTransients(m_TransientImages, m_TransientBlocks);
+
+    m_TransientImages.clear();
+    m_TransientBlocks.clear();
+    reset();
+}
+
+void RenderGraph::reset(std::pmr::memory_resource *memory) {
+    m_Passes.clear();
+    m_Resources.clear();
+    m_Memory = memory;
+}
+
+std::uint32_t RenderGraph::importImage(const char *name, VkImage image, VkImageView view, VkImageAspectFlags aspect, VkImageLayout finalLayout, VkPipelineStageFlags2 waitStage) {
+    m_Resources.emplace_back(Resource{
+        .Name = name,
+        .IsImage = true,
+        .IsTransient = false,
+        .Image = image,
+        .View = view,
+        .Buffer = VK_NULL_HANDLE,
+        .Aspect = aspect,
+        .FinalLayout = finalLayout,
+        .WaitStage = waitStage,
+        .Transient = RENDER_GRAPH_INVALID_RESOURCE,
+    });
+    return (std::uint32_t)m_Resources.size() - 1;
+}
+
+std::uint32_t RenderGraph::importBuffer(const char *name, VkBuffer buffer) {
+    m_Resources.emplace_back(Resource{
+        .Name = name,
+        .IsImage = false,
+        .IsTransient = false,
+        .Image = VK_NULL_HANDLE,
+        .View = VK_NULL_HANDLE,
+        .Buffer = buffer,
+        .FinalLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        .WaitStage = VK_PIPELINE_STAGE_2_NONE,
+        .Transient = RENDER_GRAPH_INVALID_RESOURCE,
+    });
+    return (std::uint32_t)m_Resources.size() - 1;
+}
+
+std::uint32_t RenderGraph::createImage(const char *name, const RenderGraphImageDesc &desc) {
+    m_Resources.emplace_back(Resource{
+        .Name = name,
+        .IsImage = true,
+        .IsTransient = true,
+        .Image = VK_NULL_HANDLE,
+        .View = VK_NULL_HANDLE,
+        .Buffer = VK_NULL_HANDLE,
+        .Aspect = getAspect(desc.Format),
+        .FinalLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        .WaitStage = VK_PIPELINE_STAGE_2_NONE,
+        .Desc = desc,
+        .Transient = RENDER_GRAPH_INVALID_RESOURCE,
+    });
+    return (std::uint32_t)m_Resources.size() - 1;
+}
+
+RenderGraphPassBuilder RenderGraph::addPass(const char *name, std::function<void(VkCommandBuffer commandBuffer)> &&execute) {
+    m_Passes.emplace_back(Pass{
+        .Name = name,
+        .Execute = std::move(execute),
+        .Accesses = std::pmr::vector<ResourceAccess>{m_Memory},
+        .IsCulled = false,
+    });
+    return RenderGraphPassBuilder{this, (std::uint32_t)m_Passes.size() - 1};
+}
+
+void RenderGraph::execute(VkCommandBuffer commandBuffer, std::uint64_t frameNumber) {
+    releaseRetired(frameNumber);
+
+    m_Stats.PassCount = (std::uint32_t)m_Passes.size();
+    m_Stats.CulledPassCount = 0;
+    m_Stats.BarrierCount = 0;
+    m_Stats.BarrierBatchCount = 0;
+
+    cull();
+    allocateTransients(frameNumber);
+    computeInitialStates();
+
+    for (Pass &pass : m_Passes) {
+        if (pass.IsCulled) continue;
+
+        for (const ResourceAccess &access : pass.Accesses) {
+            Resource &resource = m_Resources[access.Resource];
+            const UsageInfo info = getUsageInfo(access.Usage);
+            const VkImageLayout oldLayout = resource.State.Layout;
+
+            VkPipelineStageFlags2 srcStage{VK_PIPELINE_STAGE_2_NONE};
+            VkAccessFlags2 srcAccess{VK_ACCESS_2_NONE};
+            if (!applyAccess(resource.State, access.Usage, resource.IsImage, srcStage, srcAccess)) continue;
+
+            if (resource.IsImage) {
+                m_ImageBarriers.emplace_back(VkImageMemoryBarrier2{
+                    .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+                    .srcStageMask = srcStage,
+                    .srcAccessMask = srcAccess,
+                    .dstStageMask = info.Stage,
+                    .dstAccessMask = info.Access,
+                    .oldLayout = oldLayout,
+                    .newLayout = info.Layout,
+                    .image = resource.Image,
+                    .subresourceRange = vkinit::GetImageSubresourceRange(resource.Aspect),
+                });
+            } else {
+                m_BufferBarriers.emplace_back(VkBufferMemoryBarrier2{
+                    .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+                    .srcStageMask = srcStage,
+                    .srcAccessMask = srcAccess,
+                    .dstStageMask = info.Stage,
+                    .dstAccessMask = info.Access,
+                    .buffer = resource.Buffer,
+                    .offset = 0,
+                    .size = VK_WHOLE_SIZE,
+                });
+            }
+        }
+
+        flushBarriers(commandBuffer);
+        pass.Execute(commandBuffer);
+    }
+
+    for (Resource &resource : m_Resources) {
+        if (!resource.IsImage || resource.FinalLayout == VK_IMAGE_LAYOUT_UNDEFINED || resource.State.Layout == resource.FinalLayout) continue;
+
+        m_ImageBarriers.emplace_back(VkImageMemoryBarrier2{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+            .srcStageMask = resource.State.WriteStage | resource.State.ReadStages,
+            .srcAccessMask = resource.State.WriteAccess,
+            .dstStageMask = VK_PIPELINE_STAGE_2_NONE,
+            .dstAccessMask = VK_ACCESS_2_NONE,
+            .oldLayout = resource.State.Layout,
+            .newLayout = resource.FinalLayout,
+            .image = resource.Image,
+            .subresourceRange = vkinit::GetImageSubresourceRange(resource.Aspect),
+        });
+        resource.State.Layout = resource.FinalLayout;
+    }
+    flushBarriers(commandBuffer);
+}
+
+VkImage RenderGraph::getImage(std::uint32_t resource) const {
+    return m_Resources[resource].Image;
+}
+
+VkImageView RenderGraph::getImageView(std::uint32_t resource) const {
+    return m_Resources[resource].View;
+}
+
+const RenderGraphStats &RenderGraph::getStats() const {
+    return m_Stats;
+}
+
+bool RenderGraph::applyAccess(ResourceState &state, RenderGraphUsage usage, bool isImage, VkPipelineStageFlags2 &srcStage, VkAccessFlags2 &srcAccess) {
+    const UsageInfo info = getUsageInfo(usage);
+    const bool isLayoutChange = isImage && state.Layout != info.Layout;
+
+    if (info.IsWrite || isLayoutChange) {
+        srcStage = state.WriteStage | state.ReadStages;
+        srcAccess = state.WriteAccess;
+
+        if (isImage) state.Layout = info.Layout;
+        state.WriteStage = info.Stage;
+        state.WriteAccess = info.Access & WRITE_ACCESS_MASK;
+        state.ReadStages = info.IsWrite ? VK_PIPELINE_STAGE_2_NONE : info.Stage;
+        state.VisibleStages = info.IsWrite ? VK_PIPELINE_STAGE_2_NONE : info.Stage;
+        state.VisibleAccess = info.IsWrite ? VK_ACCESS_2_NONE : info.Access;
+
+        return isLayoutChange || srcStage != VK_PIPELINE_STAGE_2_NONE;
+    }
+
+    const bool isVisible = (info.Stage & ~state.VisibleStages) == 0 && (info.Access & ~state.VisibleAccess) == 0;
+    const bool hasDependency = state.WriteStage != VK_PIPELINE_STAGE_2_NONE && !isVisible;
+
+    srcStage = state.WriteStage;
+    srcAccess = state.WriteAccess;
+
+    state.ReadStages |= info.Stage;
+    state.VisibleStages |= info.Stage;
+    state.VisibleAccess |= info.Access;
+
+    return hasDependency;
+}
+
+void RenderGraph::cull() {
+    std::pmr::vector<bool> isNeeded(m_Resources.size(), false, m_Memory);
+    for (std::size_t i = 0; i < m_Resources.size(); i++) {
+        isNeeded[i] = m_Resources[i].FinalLayout != VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+
+    for (std::size_t i = m_Passes.size(); i-- > 0;) {
+        Pass &pass = m_Passes[i];
+
+        pass.IsCulled = std::none_of(pass.Accesses.begin(), pass.Accesses.end(), [&](const ResourceAccess &access) {
+            return getUsageInfo(access.Usage).IsWrite && isNeeded[access.Resource];
+        });
+        if (pass.IsCulled) {
+            m_Stats.CulledPassCount++;
+            continue;
+        }
+
+        for (const ResourceAccess &access : pass.Accesses) {
+            const UsageInfo info = getUsageInfo(access.Usage);
+            if (info.IsWrite && !info.IsRead) isNeeded[access.Resource] = false;
+        }
+        for (const ResourceAccess &access : pass.Accesses) {
+            if (getUsageInfo(access.Usage).IsRead) isNeeded[access.Resource] = true;
+        }
+    }
+
+    for (Resource &resource : m_Resources) {
+        resource.FirstPass = RENDER_GRAPH_INVALID_RESOURCE;
+        resource.LastPass = RENDER_GRAPH_INVALID_RESOURCE;
+        resource.Usage = 0;
+    }
+
+    for (std::uint32_t i = 0; i < m_Passes.size(); i++) {
+        if (m_Passes[i].IsCulled) continue;
+
+        for (const ResourceAccess &access : m_Passes[i].Accesses) {
+            Resource &resource = m_Resources[access.Resource];
+            if (resource.FirstPass == RENDER_GRAPH_INVALID_RESOURCE) resource.FirstPass = i;
+            resource.LastPass = i;
+            resource.Usage |= getUsageInfo(access.Usage).ImageUsage;
+        }
+    }
+}
+
+void RenderGraph::allocateTransients(std::uint64_t frameNumber) {
+    std::pmr::vector<std::uint32_t> transients{m_Memory};
+    for (std::uint32_t i = 0; i < m_Resources.size(); i++) {
+        if (m_Resources[i].IsTransient && m_Resources[i].FirstPass != RENDER_GRAPH_INVALID_RESOURCE) transients.emplace_back(i);
+    }
+    std::stable_sort(transients.begin(), transients.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return m_Resources[a].FirstPass < m_Resources[b].FirstPass;
+    });
+
+    std::pmr::vector<TransientImage> images{m_Memory};
+    images.reserve(transients.size());
+    for (std::uint32_t resource : transients) {
+        images.emplace_back(TransientImage{
+            .Desc = m_Resources[resource].Desc,
+            .Usage = m_Resources[resource].Usage,
+            .FirstPass = m_Resources[resource].FirstPass,
+            .LastPass = m_Resources[resource].LastPass,
+            .Block = RENDER_GRAPH_INVALID_RESOURCE,
+            .Previous = RENDER_GRAPH_INVALID_RESOURCE,
+        });
+    }
+
+    const bool isCached = std::equal(images.begin(), images.end(), m_TransientImages.begin(), m_TransientImages.end(), [](const TransientImage &a, const TransientImage &b) {
+        return a.Desc == b.Desc && a.Usage == b.Usage && a.FirstPass == b.FirstPass && a.LastPass == b.LastPass;
+    });
+
+    if (!isCached) {
+        if (!m_TransientImages.empty()) {
+            m_RetiredTransients.emplace_back(RetiredTransients{
+                .Images = std::move(m_TransientImages),
+                .Blocks = std::move(m_TransientBlocks),
+                .FrameNumber = frameNumber,
+            });
+        }
+
+        m_TransientImages.assign(images.begin(), images.end());
+        m_TransientBlocks.clear();
+
+        VkDeviceSize requestedBytes = 0;
+        for (std::uint32_t i = 0; i < m_TransientImages.size(); i++) {
+            TransientImage &image = m_TransientImages[i];
+
+            VkImageCreateInfo imageInfo = vkinit::GetImageCreateInfo(image.Desc.Format, image.Usage, VkExtent3D{image.Desc.Extent.width, image.Desc.Extent.height, 1});
+            VK_CHECK(vkCreateImage(m_Device, &imageInfo, nullptr, &image.Image));
+
+            VkMemoryRequirements requirements{};
+            vkGetImageMemoryRequirements(m_Device, image.Image, &requirements);
+            requestedBytes += requirements.size;
+
+            std::vector<TransientBlock>::iterator block = std::find_if(m_TransientBlocks.begin(), m_TransientBlocks.end(), [&](const TransientBlock &block) {
+                return m_TransientImages[block.LastImage].LastPass < image.FirstPass && (block.Requirements.memoryTypeBits & requirements.memoryTypeBits) != 0;
+            });
+
+            if (block == m_TransientBlocks.end()) {
+                image.Block = (std::uint32_t)m_TransientBlocks.size();
+                m_TransientBlocks.emplace_back(TransientBlock{
+                    .Allocation = nullptr,
+                    .Requirements = requirements,
+                    .LastImage = i,
+                });
+                continue;
+            }
+
+            image.Block = (std::uint32_t)(block - m_TransientBlocks.begin());
+            image.Previous = block->LastImage;
+            block->Requirements.size = std::max(block->Requirements.size, requirements.size);
+            block->Requirements.alignment = std::max(block->Requirements.alignment, requirements.alignment);
+            block->Requirements.memoryTypeBits &= requirements.memoryTypeBits;
+            block->LastImage = i;
+        }
+
+        VmaAllocationCreateInfo allocationInfo{
+            .usage = VMA_MEMORY_USAGE_GPU_ONLY,
+            .requiredFlags = VkMemoryPropertyFlags(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+        };
+
+        m_Stats.TransientBytes = 0;
+        for (TransientBlock &block : m_TransientBlocks) {
+            VK_CHECK(vmaAllocateMemory(m_Allocator, &block.Requirements, &allocationInfo, &block.Allocation, nullptr));
+            m_MemoryTelemetry->track(block.Allocation, MemoryCategory::RenderTarget);
+            m_Stats.TransientBytes += block.Requirements.size;
+        }
+
+        for (TransientImage &image : m_TransientImages) {
+            const TransientBlock &block = m_TransientBlocks[image.Block];
+            VK_CHECK(vmaBindImageMemory(m_Allocator, block.Allocation, image.Image));
+
+            VkImageViewCreateInfo viewInfo = vkinit::GetImageViewCreateInfo(image.Desc.Format, image.Image, getAspect(image.Desc.Format));
+            VK_CHECK(vkCreateImageView(m_Device, &viewInfo, nullptr, &image.View));
+
+            if (image.Previous == RENDER_GRAPH_INVALID_RESOURCE) image.Previous = block.LastImage;
+        }
+
+        m_Stats.TransientImageCount = (std::uint32_t)m_TransientImages.size();
+        m_Stats.TransientBlockCount = (std::uint32_t)m_TransientBlocks.size();
+        m_Stats.TransientAliasedBytes = requestedBytes - m_Stats.TransientBytes;
+    }
+
+    for (std::uint32_t i = 0; i < transients.size(); i++) {
+        Resource &resource = m_Resources[transients[i]];
+        resource.Transient = i;
+        resource.Image = m_TransientImages[i].Image;
+        resource.View = m_TransientImages[i].View;
+    }
+}
+
+void RenderGraph::computeInitialStates() {
+    std::pmr::vector<ResourceState> finalStates(m_Resources.size(), ResourceState{}, m_Memory);
+    for (const Pass &pass : m_Passes) {
+        if (pass.IsCulled) continue;
+
+        for (const ResourceAccess &access : pass.Accesses) {
+            VkPipelineStageFlags2 srcStage{VK_PIPELINE_STAGE_2_NONE};
+            VkAccessFlags2 srcAccess{VK_ACCESS_2_NONE};
+            applyAccess(finalStates[access.Resource], access.Usage, m_Resources[access.Resource].IsImage, srcStage, srcAccess);
+        }
+    }
+
+    std::pmr::vector<std::uint32_t> transientResources(m_TransientImages.size(), RENDER_GRAPH_INVALID_RESOURCE, m_Memory);
+    for (std::uint32_t i = 0; i < m_Resources.size(); i++) {
+        if (m_Resources[i].Transient != RENDER_GRAPH_INVALID_RESOURCE) transientResources[m_Resources[i].Transient] = i;
+    }
+
+    for (std::uint32_t i = 0; i < m_Resources.size(); i++) {
+        Resource &resource = m_Resources[i];
+
+        const ResourceState *source = &finalStates[i];
+        if (resource.Transient != RENDER_GRAPH_INVALID_RESOURCE) {
+            source = &finalStates[transientResources[m_TransientImages[resource.Transient].Previous]];
+        }
+
+        resource.State = ResourceState{
+            .Layout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .WriteStage = source->WriteStage,
+            .WriteAccess = source->WriteAccess,
+            .ReadStages = source->ReadStages,
+        };
+
+        if (resource.WaitStage != VK_PIPELINE_STAGE_2_NONE) {
+            resource.State = ResourceState{
+                .Layout = VK_IMAGE_LAYOUT_UNDEFINED,
+                .WriteStage = resource.WaitStage,
+            };
+        }
+    }
+}
+
+void RenderGraph::flushBarriers(VkCommandBuffer commandBuffer) {
+    if (m_ImageBarriers.empty() && m_BufferBarriers.empty()) return;
+
+    VkDependencyInfo dependencyInfo{
+        .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+        .bufferMemoryBarrierCount = (std::uint32_t)m_BufferBarriers.size(),
+        .pBufferMemoryBarriers = m_BufferBarriers.data(),
+        .imageMemoryBarrierCount = (std::uint32_t)m_ImageBarriers.size(),
+        .pImageMemoryBarriers = m_ImageBarriers.data(),
+    };
+    vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+    m_Stats.BarrierCount += (std::uint32_t)(m_ImageBarriers.size() + m_BufferBarriers.size());
+    m_Stats.BarrierBatchCount++;
+
+    m_ImageBarriers.clear();
+    m_BufferBarriers.clear();
+}
+
+void RenderGraph::destroyTransients(const std::vector<TransientImage> &images, const std::vector<TransientBlock> &blocks) {
+    for (const TransientImage &image : images) {
+        vkDestroyImageView(m_Device, image.View, nullptr);
+        vkDestroyImage(m_Device, image.Image, nullptr);
+    }
+
+    for (const TransientBlock &block : blocks) {
+        m_MemoryTelemetry->untrack(block.Allocation);
+        vmaFreeMemory(m_Allocator, block.Allocation);
+    }
+}
+
+void RenderGraph::releaseRetired(std::uint64_t frameNumber) {
+    while (!m_RetiredTransients.empty() && (frameNumber == ~0ULL || m_RetiredTransients.front().FrameNumber + m_FramesInFlight <= frameNumber)) {
+        const RetiredTransients &retired = m_RetiredTransients.front();
+        destroyTransients(retired.Images, retired.Blocks);
+        m_RetiredTransients.pop_front();
+    }
+}
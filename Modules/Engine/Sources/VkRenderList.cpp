@@ -0,0 +1,280 @@
+#include <VkGuide/VkRenderList.hpp>
+#include <VkGuide/VkDynamicState.hpp>
+#include <VkGuide/VkJobs.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+constexpr std::uint32_t RADIX_SORT_PARALLEL_THRESHOLD{4096};
+constexpr std::uint32_t RADIX_SORT_MIN_CHUNK_SIZE{2048};
+
+namespace drawkey {
+    static std::uint64_t Field(std::uint64_t value, std::uint32_t bits, std::uint32_t shift) {
+        return (value & ((1ULL << bits) - 1ULL)) << shift;
+    }
+
+    std::uint64_t Make(RenderPassType pass, std::uint32_t pipeline, std::uint32_t material, std::uint32_t mesh, float depth) {
+        const float clampedDepth = std::clamp(depth, 0.0f, 1.0f);
+        std::uint64_t quantizedDepth = (std::uint64_t)(clampedDepth * (float)((1U << DEPTH_BITS) - 1U));
+        if (pass == RenderPassType::Transparent) {
+            quantizedDepth = ((1U << DEPTH_BITS) - 1U) - quantizedDepth;
+        }
+
+        return Field((std::uint64_t)pass, PASS_BITS, PASS_SHIFT) |
+               Field(pipeline, PIPELINE_BITS, PIPELINE_SHIFT) |
+               Field(material, MATERIAL_BITS, MATERIAL_SHIFT) |
+               Field(mesh, MESH_BITS, MESH_SHIFT) |
+               Field(quantizedDepth, DEPTH_BITS, DEPTH_SHIFT);
+    }
+
+    std::uint64_t StripDepth(std::uint64_t key) {
+        return key & ~(((1ULL << DEPTH_BITS) - 1ULL) << DEPTH_SHIFT);
+    }
+}  // namespace drawkey
+
+void RenderList::clear() {
+    m_Objects.clear();
+    m_Keys.clear();
+    m_Order.clear();
+}
+
+std::uint32_t RenderList::getPipelineId(VkPipeline pipeline) {
+    std::unordered_map<VkPipeline, std::uint32_t>::iterator it = m_PipelineIds.find(pipeline);
+    if (it != m_PipelineIds.end()) return it->second;
+
+    std::uint32_t id = m_NextPipelineId;
+    if (!m_FreePipelineIds.empty()) {
+        id = m_FreePipelineIds.back();
+        m_FreePipelineIds.pop_back();
+    } else {
+        m_NextPipelineId++;
+    }
+    assert(id < (1U << drawkey::PIPELINE_BITS));
+
+    m_PipelineIds.emplace(pipeline, id);
+    return id;
+}
+
+void RenderList::replacePipeline(VkPipeline retired, VkPipeline pipeline) {
+    std::unordered_map<VkPipeline, std::uint32_t>::iterator it = m_PipelineIds.find(retired);
+    if (it == m_PipelineIds.end()) return;
+
+    const std::uint32_t id = it->second;
+    m_PipelineIds.erase(it);
+
+    if (!m_PipelineIds.emplace(pipeline, id).second) {
+        m_FreePipelineIds.emplace_back(id);
+    }
+}
+
+std::uint32_t RenderList::getMeshId(VkBuffer indexBuffer, std::uint32_t firstIndex) {
+    const MeshKey key{.IndexBuffer = indexBuffer, .FirstIndex = firstIndex};
+
+    std::unordered_map<MeshKey, std::uint32_t, MeshKeyHash>::iterator it = m_MeshIds.find(key);
+    if (it != m_MeshIds.end()) return it->second;
+
+    const std::uint32_t id = (std::uint32_t)m_MeshIds.size();
+    assert(id < (1U << drawkey::MESH_BITS));
+
+    m_MeshIds.emplace(key, id);
+    return id;
+}
+
+void RenderList::add(const RenderObject &object, std::uint64_t sortKey) {
+    m_Order.emplace_back((std::uint32_t)m_Objects.size());
+    m_Objects.emplace_back(object);
+    m_Keys.emplace_back(sortKey);
+}
+
+void RenderList::sort(JobSystem *jobSystem, std::pmr::memory_resource *memory) {
+    if (m_Keys.size() < 2) return;
+
+    radixSort(jobSystem, memory);
+}
+
+static bool IsSameGeometry(const RenderObject &a, const RenderObject &b) {
+    return a.Pipeline == b.Pipeline &&
+           a.DynamicState == b.DynamicState &&
+           a.IndexBuffer == b.IndexBuffer &&
+           a.FirstIndex == b.FirstIndex &&
+           a.IndexCount == b.IndexCount &&
+           a.VertexBufferAddress == b.VertexBufferAddress;
+}
+
+DrawStats RenderList::submit(VkCommandBuffer commandBuffer, DynamicStateTracker *dynamicStateTracker, const InstanceBufferView &instances) const {
+    DrawStats stats{.ObjectCount = getObjectCount()};
+
+    VkPipeline lastPipeline{VK_NULL_HANDLE};
+    const PipelineDynamicState *lastDynamicState{nullptr};
+    VkBuffer lastIndexBuffer{VK_NULL_HANDLE};
+    VkPipelineLayout lastLayout{VK_NULL_HANDLE};
+    VkDeviceAddress lastVertexBuffer{0};
+
+    GPUDrawPushConstants pushConstants{
+        .InstanceBuffer = instances.Address,
+    };
+
+    std::uint32_t instanceIndex = instances.First;
+    const std::uint32_t objectCount = getObjectCount();
+
+    for (std::uint32_t first = 0; first < objectCount;) {
+        const RenderObject &object = m_Objects[m_Order[first]];
+        const std::uint64_t batchKey = drawkey::StripDepth(m_Keys[first]);
+
+        std::uint32_t last = first + 1;
+        while (last < objectCount && drawkey::StripDepth(m_Keys[last]) == batchKey && IsSameGeometry(object, m_Objects[m_Order[last]])) {
+            last++;
+        }
+
+        const std::uint32_t batchSize = std::min(last - first, instances.Capacity - instanceIndex);
+        if (batchSize == 0) {
+            stats.DroppedObjects = objectCount - first;
+            break;
+        }
+
+        for (std::uint32_t i = 0; i < batchSize; i++) {
+            const RenderObject &instance = m_Objects[m_Order[first + i]];
+            instances.Data[instanceIndex + i] = GPUInstanceData{
+                .WorldMatrix = instance.Transform,
+                .TextureIndex = instance.TextureIndex,
+                .SamplerIndex = instance.SamplerIndex,
+            };
+        }
+
+        if (object.Pipeline != lastPipeline) {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, object.Pipeline);
+            lastPipeline = object.Pipeline;
+            stats.PipelineBinds++;
+        } else {
+            stats.SkippedPipelineBinds++;
+        }
+
+        if (dynamicStateTracker != nullptr && object.DynamicState != nullptr && object.DynamicState != lastDynamicState) {
+            dynamicStateTracker->apply(*object.DynamicState);
+            lastDynamicState = object.DynamicState;
+            stats.DynamicStateChanges++;
+        }
+
+        if (object.IndexBuffer != lastIndexBuffer) {
+            vkCmdBindIndexBuffer(commandBuffer, object.IndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+            lastIndexBuffer = object.IndexBuffer;
+            stats.IndexBufferBinds++;
+        } else {
+            stats.SkippedIndexBufferBinds++;
+        }
+
+        if (object.Layout != lastLayout || object.VertexBufferAddress != lastVertexBuffer) {
+            pushConstants.VertexBuffer = object.VertexBufferAddress;
+            vkCmdPushConstants(commandBuffer, object.Layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(GPUDrawPushConstants), &pushConstants);
+            lastLayout = object.Layout;
+            lastVertexBuffer = object.VertexBufferAddress;
+            stats.PushConstantUpdates++;
+        }
+
+        vkCmdDrawIndexed(commandBuffer, object.IndexCount, batchSize, object.FirstIndex, 0, instanceIndex);
+        stats.DrawCalls++;
+        stats.InstanceCount += batchSize;
+
+        instanceIndex += batchSize;
+        first += batchSize;
+    }
+
+    return stats;
+}
+
+std::uint32_t RenderList::getObjectCount() const {
+    return (std::uint32_t)m_Objects.size();
+}
+
+std::span<const std::uint64_t> RenderList::getSortedKeys() const {
+    return m_Keys;
+}
+
+std::span<const std::uint32_t> RenderList::getSortedOrder() const {
+    return m_Order;
+}
+
+const RenderObject &RenderList::getObject(std::uint32_t index) const {
+    return m_Objects[index];
+}
+
+std::size_t RenderList::MeshKeyHash::operator()(const MeshKey &key) const {
+    return std::hash<VkBuffer>{}(key.IndexBuffer) ^ (std::hash<std::uint32_t>{}(key.FirstIndex) * 0x9E3779B97F4A7C15ULL);
+}
+
+void RenderList::radixSort(JobSystem *jobSystem, std::pmr::memory_resource *memory) {
+    const std::uint32_t count = (std::uint32_t)m_Keys.size();
+
+    std::uint32_t chunkCount{1};
+    if (jobSystem != nullptr && count >= RADIX_SORT_PARALLEL_THRESHOLD) {
+        chunkCount = std::clamp(count / RADIX_SORT_MIN_CHUNK_SIZE, 1U, jobSystem->getWorkerCount() + 1);
+    }
+    const std::uint32_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    std::pmr::vector<std::uint64_t> scratchKeys(count, memory);
+    std::pmr::vector<std::uint32_t> scratchOrder(count, memory);
+    std::pmr::vector<std::array<std::uint32_t, 256>> histograms(chunkCount, memory);
+
+    auto forEachChunk = [&](const std::function<void(std::uint32_t chunk, std::uint32_t begin, std::uint32_t end)> &function) {
+        auto runChunks = [&](std::uint32_t firstChunk, std::uint32_t lastChunk) {
+            for (std::uint32_t chunk = firstChunk; chunk < lastChunk; chunk++) {
+                const std::uint32_t begin = chunk * chunkSize;
+                function(chunk, begin, std::min(begin + chunkSize, count));
+            }
+        };
+
+        if (chunkCount == 1) {
+            runChunks(0, 1);
+        } else {
+            jobSystem->parallelFor(chunkCount, 1, runChunks);
+        }
+    };
+
+    std::uint64_t varyingBits{0};
+    for (std::uint64_t key : m_Keys) {
+        varyingBits |= key ^ m_Keys[0];
+    }
+
+    std::uint64_t *srcKeys = m_Keys.data();
+    std::uint64_t *dstKeys = scratchKeys.data();
+    std::uint32_t *srcOrder = m_Order.data();
+    std::uint32_t *dstOrder = scratchOrder.data();
+
+    for (std::uint32_t shift = 0; shift < 64; shift += 8) {
+        if (((varyingBits >> shift) & 0xFF) == 0) continue;
+
+        forEachChunk([&](std::uint32_t chunk, std::uint32_t begin, std::uint32_t end) {
+            std::array<std::uint32_t, 256> &histogram = histograms[chunk];
+            histogram.fill(0);
+            for (std::uint32_t i = begin; i < end; i++) {
+                histogram[(srcKeys[i] >> shift) & 0xFF]++;
+            }
+        });
+
+        std::uint32_t offset{0};
+        for (std::uint32_t digit = 0; digit < 256; digit++) {
+            for (std::uint32_t chunk = 0; chunk < chunkCount; chunk++) {
+                const std::uint32_t digitCount = histograms[chunk][digit];
+                histograms[chunk][digit] = offset;
+                offset += digitCount;
+            }
+        }
+
+        forEachChunk([&](std::uint32_t chunk, std::uint32_t begin, std::uint32_t end) {
+            std::array<std::uint32_t, 256> &offsets = histograms[chunk];
+            for (std::uint32_t i = begin; i < end; i++) {
+                const std::uint32_t position = offsets[(srcKeys[i] >> shift) & 0xFF]++;
+                dstKeys[position] = srcKeys[i];
+                dstOrder[position] = srcOrder[i];
+            }
+        });
+
+        std::swap(srcKeys, dstKeys);
+        std::swap(srcOrder, dstOrder);
+    }
+
+    if (srcKeys != m_Keys.data()) {
+        std::copy(srcKeys, srcKeys + count, m_Keys.data());
+        std::copy(srcOrder, srcOrder + count, m_Order.data());
+    }
+}
@@ -0,0 +1,86 @@
+#include <VkGuide/VkResourcePools.hpp>
+#include <VkGuide/VkDeletionQueue.hpp>
+#include <VkGuide/VkMemoryTelemetry.hpp>
+
+void ResourcePools::init(VkDevice device, VmaAllocator allocator, MemoryTelemetry *memoryTelemetry, DeferredDeletionQueue *deletionQueue) {
+    m_Device = device;
+    m_Allocator = allocator;
+    m_MemoryTelemetry = memoryTelemetry;
+    m_DeletionQueue = deletionQueue;
+}
+
+void ResourcePools::destroy() {
+    for (const GPUMeshBuffers &mesh : m_Meshes.values()) {
+        destroyBuffer(mesh.IndexBuffer);
+        destroyBuffer(mesh.VertexBuffer);
+    }
+    for (const AllocatedImage &image : m_Images.values()) {
+        destroyImage(image);
+    }
+
+    m_Meshes.clear();
+    m_Images.clear();
+}
+
+ImageHandle ResourcePools::addImage(const AllocatedImage &image) {
+    return m_Images.insert(AllocatedImage{image});
+}
+
+MeshHandle ResourcePools::addMesh(const GPUMeshBuffers &mesh) {
+    return m_Meshes.insert(GPUMeshBuffers{mesh});
+}
+
+const AllocatedImage *ResourcePools::getImage(ImageHandle handle) {
+    return lookup(m_Images, handle);
+}
+
+const GPUMeshBuffers *ResourcePools::getMesh(MeshHandle handle) {
+    return lookup(m_Meshes, handle);
+}
+
+void ResourcePools::releaseImage(ImageHandle handle, std::uint64_t frameNumber) {
+    std::optional<AllocatedImage> image = m_Images.remove(handle);
+    if (!image.has_value()) {
+        m_StaleLookupCount++;
+        return;
+    }
+
+    m_DeletionQueue->pushImage(image.value(), frameNumber);
+}
+
+void ResourcePools::releaseMesh(MeshHandle handle, std::uint64_t frameNumber) {
+    std::optional<GPUMeshBuffers> mesh = m_Meshes.remove(handle);
+    if (!mesh.has_value()) {
+        m_StaleLookupCount++;
+        return;
+    }
+
+    m_DeletionQueue->pushBuffer(mesh->IndexBuffer, frameNumber);
+    m_DeletionQueue->pushBuffer(mesh->VertexBuffer, frameNumber);
+}
+
+ResourcePoolStats ResourcePools::getStats() const {
+    return ResourcePoolStats{
+        .ImageCount = m_Images.size(),
+        .MeshCount = m_Meshes.size(),
+        .StaleLookupCount = m_StaleLookupCount,
+    };
+}
+
+template <typename T>
+const T *ResourcePools::lookup(const SlotMap<T> &pool, ResourceHandle<T> handle) {
+    const T *value = pool.get(handle);
+    if (value == nullptr) m_StaleLookupCount++;
+    return value;
+}
+
+void ResourcePools::destroyBuffer(const AllocatedBuffer &buffer) {
+    m_MemoryTelemetry->untrack(buffer.Allocation);
+    vmaDestroyBuffer(m_Allocator, buffer.Buffer, buffer.Allocation);
+}
+
+void ResourcePools::destroyImage(const AllocatedImage &image) {
+    vkDestroyImageView(m_Device, image.View, nullptr);
+    m_MemoryTelemetry->untrack(image.Allocation);
+    vmaDestroyImage(m_Allocator, image.Image, image.Allocation);
+}
@@ -0,0 +1,218 @@
+#include <VkGuide/VkScene.hpp>
+#include <VkGuide/VkJobs.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+
+constexpr std::uint32_t SCENE_UPDATE_BATCH_SIZE{256};
+
+void SceneGraph::clear() {
+    m_Names.clear();
+    m_Parents.clear();
+    m_Depths.clear();
+    m_MeshIndices.clear();
+    m_Translations.clear();
+    m_Rotations.clear();
+    m_Scales.clear();
+    m_LocalMatrices.clear();
+    m_WorldMatrices.clear();
+    m_Dirty.clear();
+    m_LevelOffsets.clear();
+    m_AnyDirty = false;
+    m_LastUpdatedCount = 0;
+}
+
+std::uint32_t SceneGraph::addNode(const NodeDescription &description) {
+    const std::uint32_t node = (std::uint32_t)m_Parents.size();
+    assert(description.Parent == SCENE_NO_PARENT || description.Parent < node);
+
+    m_Names.emplace_back(description.Name);
+    m_Parents.emplace_back(description.Parent);
+    m_Depths.emplace_back(description.Parent == SCENE_NO_PARENT ? 0U : m_Depths[description.Parent] + 1);
+    m_MeshIndices.emplace_back(description.MeshIndex);
+    m_Translations.emplace_back(description.Translation);
+    m_Rotations.emplace_back(description.Rotation);
+    m_Scales.emplace_back(description.Scale);
+    m_LocalMatrices.emplace_back(1.0f);
+    m_WorldMatrices.emplace_back(1.0f);
+    m_Dirty.emplace_back(1);
+
+    m_AnyDirty = true;
+    return node;
+}
+
+void SceneGraph::finalize() {
+    const std::uint32_t nodeCount = getNodeCount();
+
+    std::vector<std::uint32_t> order(nodeCount);
+    std::iota(order.begin(), order.end(), 0U);
+    std::stable_sort(order.begin(), order.end(), [this](std::uint32_t a, std::uint32_t b) {
+        return m_Depths[a] < m_Depths[b];
+    });
+
+    std::vector<std::uint32_t> remap(nodeCount);
+    for (std::uint32_t i = 0; i < nodeCount; i++) {
+        remap[order[i]] = i;
+    }
+
+    auto permute = [&order](auto &values) {
+        std::remove_reference_t<decltype(values)> sorted{};
+        sorted.reserve(values.size());
+        for (std::uint32_t index : order) {
+            sorted.emplace_back(std::move(values[index]));
+        }
+        values = std::move(sorted);
+    };
+
+    permute(m_Names);
+    permute(m_Parents);
+    permute(m_Depths);
+    permute(m_MeshIndices);
+    permute(m_Translations);
+    permute(m_Rotations);
+    permute(m_Scales);
+
+    for (std::uint32_t &parent : m_Parents) {
+        if (parent != SCENE_NO_PARENT) parent = remap[parent];
+    }
+
+    m_LevelOffsets.clear();
+    for (std::uint32_t i = 0; i < nodeCount; i++) {
+        while (m_LevelOffsets.size() <= m_Depths[i]) {
+            m_LevelOffsets.emplace_back(i);
+        }
+    }
+    m_LevelOffsets.emplace_back(nodeCount);
+
+    std::fill(m_Dirty.begin(), m_Dirty.end(), 1);
+    m_AnyDirty = nodeCount > 0;
+}
+
+void SceneGraph::setTranslation(std::uint32_t node, const glm::vec3 &translation) {
+    m_Translations[node] = translation;
+    markDirty(node);
+}
+
+void SceneGraph::setRotation(std::uint32_t node, const glm::quat &rotation) {
+    m_Rotations[node] = rotation;
+    markDirty(node);
+}
+
+void SceneGraph::setScale(std::uint32_t node, const glm::vec3 &scale) {
+    m_Scales[node] = scale;
+    markDirty(node);
+}
+
+void SceneGraph::updateTransforms(JobSystem *jobSystem) {
+    m_LastUpdatedCount = 0;
+    if (!m_AnyDirty) return;
+
+    assert(!m_LevelOffsets.empty());
+
+    std::atomic<std::uint32_t> updatedCount{0};
+    for (std::uint32_t level = 0; level + 1 < m_LevelOffsets.size(); level++) {
+        const std::uint32_t begin = m_LevelOffsets[level];
+        const std::uint32_t end = m_LevelOffsets[level + 1];
+
+        if (jobSystem == nullptr || end - begin <= SCENE_UPDATE_BATCH_SIZE) {
+            updatedCount += updateRange(begin, end);
+            continue;
+        }
+
+        jobSystem->parallelFor(end - begin, SCENE_UPDATE_BATCH_SIZE, [&](std::uint32_t first, std::uint32_t last) {
+            updatedCount += updateRange(begin + first, begin + last);
+        });
+    }
+
+    std::fill(m_Dirty.begin(), m_Dirty.end(), 0);
+    m_AnyDirty = false;
+    m_LastUpdatedCount = updatedCount.load();
+}
+
+std::uint32_t SceneGraph::findNode(const std::string &name) const {
+    std::vector<std::string>::const_iterator it = std::find(m_Names.begin(), m_Names.end(), name);
+    return it == m_Names.end() ? SCENE_NO_PARENT : (std::uint32_t)(it - m_Names.begin());
+}
+
+std::uint32_t SceneGraph::getNodeCount() const {
+    return (std::uint32_t)m_Parents.size();
+}
+
+std::uint32_t SceneGraph::getLevelCount() const {
+    return m_LevelOffsets.empty() ? 0U : (std::uint32_t)m_LevelOffsets.size() - 1;
+}
+
+std::uint32_t SceneGraph::getLastUpdatedCount() const {
+    return m_LastUpdatedCount;
+}
+
+const std::string &SceneGraph::getName(std::uint32_t node) const {
+    return m_Names[node];
+}
+
+std::uint32_t SceneGraph::getParent(std::uint32_t node) const {
+    return m_Parents[node];
+}
+
+std::int32_t SceneGraph::getMeshIndex(std::uint32_t node) const {
+    return m_MeshIndices[node];
+}
+
+const glm::vec3 &SceneGraph::getTranslation(std::uint32_t node) const {
+    return m_Translations[node];
+}
+
+const glm::quat &SceneGraph::getRotation(std::uint32_t node) const {
+    return m_Rotations[node];
+}
+
+const glm::vec3 &SceneGraph::getScale(std::uint32_t node) const {
+    return m_Scales[node];
+}
+
+const glm::mat4 &SceneGraph::getLocalMatrix(std::uint32_t node) const {
+    return m_LocalMatrices[node];
+}
+
+const glm::mat4 &SceneGraph::getWorldMatrix(std::uint32_t node) const {
+    return m_WorldMatrices[node];
+}
+
+std::span<const glm::mat4> SceneGraph::getWorldMatrices() const {
+    return m_WorldMatrices;
+}
+
+std::span<const std::int32_t> SceneGraph::getMeshIndices() const {
+    return m_MeshIndices;
+}
+
+void SceneGraph::markDirty(std::uint32_t node) {
+    m_Dirty[node] = 1;
+    m_AnyDirty = true;
+}
+
+std::uint32_t SceneGraph::updateRange(std::uint32_t begin, std::uint32_t end) {
+    std::uint32_t updated{0};
+
+    for (std::uint32_t node = begin; node < end; node++) {
+        const std::uint32_t parent = m_Parents[node];
+        if (parent != SCENE_NO_PARENT && m_Dirty[parent]) {
+            m_Dirty[node] = 1;
+        }
+
+        if (!m_Dirty[node]) continue;
+
+        m_LocalMatrices[node] =
+            glm::translate(glm::mat4{1.0f}, m_Translations[node]) *
+            glm::mat4_cast(m_Rotations[node]) *
+            glm::scale(glm::mat4{1.0f}, m_Scales[node]);
+
+        m_WorldMatrices[node] = parent == SCENE_NO_PARENT ? m_LocalMatrices[node] : m_WorldMatrices[parent] * m_LocalMatrices[node];
+        updated++;
+    }
+
+    return updated;
+}
@@ -0,0 +1,344 @@
+#include <VkGuide/VkShaderArchive.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace vkutils {
+    std::uint64_t HashBytes(const void *data, std::size_t size, std::uint64_t seed) {
+        const std::uint8_t *bytes = (const std::uint8_t *)data;
+
+        std::uint64_t hash = seed;
+        for (std::size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 0x100000001B3ULL;
+        }
+        return hash;
+    }
+}  // namespace vkutils
+
+#if defined(_WIN32)
+bool ShaderArchive::open(const std::filesystem::path &filePath) {
+    assert(m_Data == nullptr);
+
+    HANDLE file = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_File = file;
+    m_Mapping = mapping;
+    m_Data = (const std::uint8_t *)data;
+    m_Size = (std::size_t)fileSize.QuadPart;
+
+    if (!validate()) {
+        fmt::println("[ERROR]: Shader archive is corrupted or outdated: {}.", filePath.string());
+        close();
+        return false;
+    }
+
+    std::error_code error{};
+    m_WriteTime = std::filesystem::last_write_time(filePath, error);
+    return true;
+}
+
+void ShaderArchive::close() {
+    if (m_Data != nullptr) UnmapViewOfFile(m_Data);
+    if (m_Mapping != nullptr) CloseHandle(m_Mapping);
+    if (m_File != nullptr) CloseHandle(m_File);
+
+    m_Data = nullptr;
+    m_Size = 0;
+    m_WriteTime = std::filesystem::file_time_type{};
+    m_Mapping = nullptr;
+    m_File = nullptr;
+}
+#else
+bool ShaderArchive::open(const std::filesystem::path &filePath) {
+    assert(m_Data == nullptr);
+
+    const int file = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file == -1) return false;
+
+    struct stat fileStat{};
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0) {
+        ::close(file);
+        return false;
+    }
+
+    void *data = mmap(nullptr, (std::size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (data == MAP_FAILED) {
+        ::close(file);
+        return false;
+    }
+
+    m_File = file;
+    m_Data = (const std::uint8_t *)data;
+    m_Size = (std::size_t)fileStat.st_size;
+
+    if (!validate()) {
+        fmt::println("[ERROR]: Shader archive is corrupted or outdated: {}.", filePath.string());
+        close();
+        return false;
+    }
+
+    std::error_code error{};
+    m_WriteTime = std::filesystem::last_write_time(filePath, error);
+    return true;
+}
+
+void ShaderArchive::close() {
+    if (m_Data != nullptr) munmap((void *)m_Data, m_Size);
+    if (m_File != -1) ::close(m_File);
+
+    m_Data = nullptr;
+    m_Size = 0;
+    m_WriteTime = std::filesystem::file_time_type{};
+    m_File = -1;
+}
+#endif
+
+bool ShaderArchive::isOpen() const {
+    return m_Data != nullptr;
+}
+
+std::optional<ShaderBlob> ShaderArchive::find(std::string_view name) const {
+    if (m_Data == nullptr) return std::nullopt;
+
+    const ShaderArchiveHeader *header = (const ShaderArchiveHeader *)m_Data;
+    const ShaderArchiveEntry *entries = (const ShaderArchiveEntry *)(m_Data + sizeof(ShaderArchiveHeader));
+
+    for (std::uint32_t i = 0; i < header->EntryCount; i++) {
+        const ShaderArchiveEntry &entry = entries[i];
+        if (name != std::string_view{entry.Name, strnlen(entry.Name, SHADER_ARCHIVE_NAME_SIZE)}) continue;
+
+        if (vkutils::HashBytes(m_Data + entry.Offset, entry.Size) != entry.ContentHash) {
+            fmt::println("[ERROR]: Shader archive entry does not match its hash: {}.", name);
+            return std::nullopt;
+        }
+
+        return ShaderBlob{
+            .Code = std::span<const std::uint32_t>{(const std::uint32_t *)(m_Data + entry.Offset), entry.Size / sizeof(std::uint32_t)},
+            .Hash = entry.ContentHash,
+        };
+    }
+
+    return std::nullopt;
+}
+
+std::filesystem::file_time_type ShaderArchive::getWriteTime() const {
+    return m_WriteTime;
+}
+
+bool ShaderArchive::Write(const std::filesystem::path &filePath, std::span<const std::filesystem::path> shaderPaths) {
+    std::vector<ShaderArchiveEntry> entries{};
+    std::vector<std::vector<char>> contents{};
+    entries.reserve(shaderPaths.size());
+    contents.reserve(shaderPaths.size());
+
+    std::uint32_t offset = sizeof(ShaderArchiveHeader) + (std::uint32_t)(shaderPaths.size() * sizeof(ShaderArchiveEntry));
+    for (const std::filesystem::path &shaderPath : shaderPaths) {
+        const std::string name = shaderPath.filename().string();
+        if (name.size() >= SHADER_ARCHIVE_NAME_SIZE) {
+            fmt::println("[ERROR]: Shader name is too long for the archive: {}.", name);
+            return false;
+        }
+
+        std::ifstream file{shaderPath, std::ios::ate | std::ios::binary};
+        if (!file.is_open()) {
+            fmt::println("[ERROR]: Failed to open file from path: {}.", shaderPath.string());
+            return false;
+        }
+
+        const std::size_t fileSize = file.tellg();
+        if (fileSize == 0 || fileSize % sizeof(std::uint32_t) != 0) {
+            fmt::println("[ERROR]: File is not a valid SPIR-V binary: {}.", shaderPath.string());
+            return false;
+        }
+
+        std::vector<char> &content = contents.emplace_back(fileSize);
+        file.seekg(0);
+        file.read(content.data(), fileSize);
+
+        ShaderArchiveEntry &entry = entries.emplace_back();
+        std::memset(&entry, 0, sizeof(entry));
+        std::memcpy(entry.Name, name.data(), name.size());
+        entry.ContentHash = vkutils::HashBytes(content.data(), content.size());
+        entry.Offset = offset;
+        entry.Size = (std::uint32_t)fileSize;
+
+        offset += (std::uint32_t)fileSize;
+        offset = (offset + SHADER_ARCHIVE_ALIGNMENT - 1) & ~(SHADER_ARCHIVE_ALIGNMENT - 1);
+    }
+
+    std::filesystem::path tempPath = filePath;
+    tempPath += ".tmp";
+
+    std::ofstream file{tempPath, std::ios::binary | std::ios::trunc};
+    if (!file.is_open()) {
+        fmt::println("[ERROR]: Failed to create shader archive: {}.", tempPath.string());
+        return false;
+    }
+
+    const ShaderArchiveHeader header{
+        .Magic = SHADER_ARCHIVE_MAGIC,
+        .Version = SHADER_ARCHIVE_VERSION,
+        .EntryCount = (std::uint32_t)entries.size(),
+        .Reserved = 0,
+    };
+
+    file.write((const char *)&header, sizeof(header));
+    file.write((const char *)entries.data(), entries.size() * sizeof(ShaderArchiveEntry));
+    for (std::size_t i = 0; i < contents.size(); i++) {
+        file.seekp(entries[i].Offset);
+        file.write(contents[i].data(), contents[i].size());
+    }
+    file.close();
+
+    std::error_code error{};
+    if (!file) {
+        fmt::println("[ERROR]: Failed to write shader archive: {}.", tempPath.string());
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    std::filesystem::rename(tempPath, filePath, error);
+    if (error) {
+        fmt::println("[ERROR]: Failed to replace shader archive: {}.", filePath.string());
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
+
+bool ShaderArchive::validate() const {
+    if (m_Size < sizeof(ShaderArchiveHeader)) return false;
+
+    const ShaderArchiveHeader *header = (const ShaderArchiveHeader *)m_Data;
+    if (header->Magic != SHADER_ARCHIVE_MAGIC || header->Version != SHADER_ARCHIVE_VERSION) return false;
+
+    const std::size_t indexEnd = sizeof(ShaderArchiveHeader) + (std::size_t)header->EntryCount * sizeof(ShaderArchiveEntry);
+    if (indexEnd > m_Size) return false;
+
+    const ShaderArchiveEntry *entries = (const ShaderArchiveEntry *)(m_Data + sizeof(ShaderArchiveHeader));
+    for (std::uint32_t i = 0; i < header->EntryCount; i++) {
+        const ShaderArchiveEntry &entry = entries[i];
+        if (entry.Offset % SHADER_ARCHIVE_ALIGNMENT != 0 || entry.Size % sizeof(std::uint32_t) != 0) return false;
+        if (entry.Offset < indexEnd || (std::size_t)entry.Offset + entry.Size > m_Size) return false;
+    }
+    return true;
+}
+
+void ShaderModuleCache::init(VkDevice device, const ShaderArchive *archive) {
+    m_Device = device;
+    m_Archive = archive;
+}
+
+void ShaderModuleCache::destroy() {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    for (const auto &[hash, cached] : m_Modules) {
+        vkDestroyShaderModule(m_Device, cached.Module, nullptr);
+    }
+    m_Modules.clear();
+}
+
+bool ShaderModuleCache::getShaderModule(const char *filePath, VkShaderModule *outShaderModule) {
+    if (m_Archive != nullptr && m_Archive->isOpen()) {
+        std::error_code error{};
+        const std::filesystem::file_time_type looseWriteTime = std::filesystem::last_write_time(filePath, error);
+
+        if (!error && looseWriteTime > m_Archive->getWriteTime()) {
+            std::lock_guard<std::mutex> lock{m_Mutex};
+            m_LooseOverrideCount++;
+        } else {
+            const std::string name = std::filesystem::path{filePath}.filename().string();
+            if (std::optional<ShaderBlob> blob = m_Archive->find(name); blob.has_value()) {
+                return createShaderModule(blob->Code, blob->Hash, outShaderModule);
+            }
+        }
+    }
+
+    std::ifstream file{filePath, std::ios::ate | std::ios::binary};
+    if (!file.is_open()) {
+        fmt::println("[ERROR]: Failed to open file from path: {}.", filePath);
+        return false;
+    }
+
+    const std::size_t fileSize = file.tellg();
+
+    std::vector<std::uint32_t> buffer{};
+    buffer.resize((fileSize + sizeof(std::uint32_t) - 1) / sizeof(std::uint32_t));
+
+    file.seekg(0);
+    file.read((char *)buffer.data(), fileSize);
+    file.close();
+
+    return createShaderModule(buffer, vkutils::HashBytes(buffer.data(), fileSize), outShaderModule);
+}
+
+std::uint32_t ShaderModuleCache::getModuleCount() const {
+    return (std::uint32_t)m_Modules.size();
+}
+
+std::uint32_t ShaderModuleCache::getHitCount() const {
+    return m_HitCount;
+}
+
+std::uint32_t ShaderModuleCache::getLooseOverrideCount() const {
+    return m_LooseOverrideCount;
+}
+
+bool ShaderModuleCache::createShaderModule(std::span<const std::uint32_t> code, std::uint64_t hash, VkShaderModule *outShaderModule) {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+
+    // A matching hash is only a hint, compare the words so a collision never hands out the wrong module.
+    const auto [first, last] = m_Modules.equal_range(hash);
+    for (auto it = first; it != last; it++) {
+        if (!std::equal(code.begin(), code.end(), it->second.Code.begin(), it->second.Code.end())) continue;
+
+        m_HitCount++;
+        *outShaderModule = it->second.Module;
+        return true;
+    }
+
+    VkShaderModuleCreateInfo info{
+        .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+        .codeSize = code.size_bytes(),
+        .pCode = code.data(),
+    };
+
+    if (vkCreateShaderModule(m_Device, &info, nullptr, outShaderModule) != VK_SUCCESS) {
+        return false;
+    }
+
+    m_Modules.emplace(hash, CachedShaderModule{.Module = *outShaderModule, .Code = {code.begin(), code.end()}});
+    return true;
+}
@@ -0,0 +1,110 @@
+#include <VkGuide/VkShaderWatcher.hpp>
+
+#include <algorithm>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+#if defined(__linux__)
+void ShaderWatcher::init() {
+    assert(m_InotifyFd == -1);
+
+    m_InotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_InotifyFd == -1) {
+        fmt::println("[ERROR]: Failed to initialize inotify, shader hot reload is disabled.");
+    }
+}
+
+void ShaderWatcher::shutdown() {
+    if (m_InotifyFd == -1) return;
+
+    for (const auto &[watchDescriptor, directory] : m_Directories) {
+        inotify_rm_watch(m_InotifyFd, watchDescriptor);
+    }
+    m_Directories.clear();
+
+    close(m_InotifyFd);
+    m_InotifyFd = -1;
+}
+
+bool ShaderWatcher::addDirectory(const std::filesystem::path &directory) {
+    if (m_InotifyFd == -1) return false;
+
+    const int watchDescriptor = inotify_add_watch(m_InotifyFd, directory.string().c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (watchDescriptor == -1) {
+        fmt::println("[ERROR]: Failed to watch shader directory: {}.", directory.string());
+        return false;
+    }
+
+    m_Directories[watchDescriptor] = directory;
+    return true;
+}
+
+std::vector<std::filesystem::path> ShaderWatcher::pollChanges() {
+    std::vector<std::filesystem::path> changes{};
+    if (m_InotifyFd == -1) return changes;
+
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        const ssize_t length = read(m_InotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) break;
+
+        for (ssize_t offset = 0; offset < length;) {
+            const inotify_event *event = (const inotify_event *)(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            if (event->len == 0) continue;
+
+            std::unordered_map<int, std::filesystem::path>::const_iterator it = m_Directories.find(event->wd);
+            if (it == m_Directories.end()) continue;
+
+            std::filesystem::path path = it->second / event->name;
+            if (std::find(changes.begin(), changes.end(), path) == changes.end()) {
+                changes.emplace_back(std::move(path));
+            }
+        }
+    }
+
+    return changes;
+}
+#else
+void ShaderWatcher::init() {}
+
+void ShaderWatcher::shutdown() {
+    m_Directories.clear();
+    m_Timestamps.clear();
+}
+
+bool ShaderWatcher::addDirectory(const std::filesystem::path &directory) {
+    std::error_code error{};
+    if (!std::filesystem::is_directory(directory, error)) return false;
+
+    for (const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator{directory, error}) {
+        m_Timestamps[entry.path().string()] = entry.last_write_time(error);
+    }
+
+    m_Directories.emplace_back(directory);
+    return true;
+}
+
+std::vector<std::filesystem::path> ShaderWatcher::pollChanges() {
+    std::vector<std::filesystem::path> changes{};
+
+    std::error_code error{};
+    for (const std::filesystem::path &directory : m_Directories) {
+        for (const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator{directory, error}) {
+            const std::filesystem::file_time_type timestamp = entry.last_write_time(error);
+            std::filesystem::file_time_type &known = m_Timestamps[entry.path().string()];
+            if (known != timestamp) {
+                known = timestamp;
+                changes.emplace_back(entry.path());
+            }
+        }
+    }
+
+    return changes;
+}
+#endif
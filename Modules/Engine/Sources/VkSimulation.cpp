@@ -0,0 +1,179 @@
+#include <VkGuide/VkSimulation.hpp>
+#include <VkGuide/VkJobs.hpp>
+#include <VkGuide/VkScene.hpp>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+
+glm::mat4 simulation::InterpolateView(const SimulationSnapshot &snapshot, float alpha) {
+    const glm::vec3 position = glm::mix(snapshot.PreviousCamera.Position, snapshot.Camera.Position, alpha);
+    const glm::vec3 front = glm::normalize(glm::mix(snapshot.PreviousCamera.Front, snapshot.Camera.Front, alpha));
+    const glm::vec3 up = glm::normalize(glm::mix(snapshot.PreviousCamera.Up, snapshot.Camera.Up, alpha));
+
+    return glm::lookAt(position, position + front, up);
+}
+
+glm::mat4 simulation::InterpolateWorldMatrix(const SimulationSnapshot &snapshot, std::uint32_t node, float alpha) {
+    assert(node < snapshot.WorldMatrices.size());
+
+    const glm::mat4 &current = snapshot.WorldMatrices[node];
+    if (node >= snapshot.PreviousWorldMatrices.size()) return current;
+
+    const glm::mat4 &previous = snapshot.PreviousWorldMatrices[node];
+    if (previous == current) return current;
+
+    glm::mat4 result{};
+    for (std::uint32_t column = 0; column < 4; column++) {
+        result[column] = glm::mix(previous[column], current[column], alpha);
+    }
+    return result;
+}
+
+void Simulation::init(SceneGraph *sceneGraph, JobSystem *jobSystem, double tickRate) {
+    assert(!m_Running);
+    assert(tickRate > 0.0);
+
+    m_SceneGraph = sceneGraph;
+    m_JobSystem = jobSystem;
+    m_TickRate = tickRate;
+    m_TickDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>{1.0 / tickRate});
+    m_Tick = 0;
+    m_Stats = SimulationStats{};
+
+    m_Camera.withPosition(glm::vec3{0.0f, 0.0f, 5.0f});
+
+    m_SceneGraph->updateTransforms(m_JobSystem);
+
+    const std::span<const glm::mat4> worldMatrices = m_SceneGraph->getWorldMatrices();
+    m_PreviousWorldMatrices.assign(worldMatrices.begin(), worldMatrices.end());
+    m_PreviousCamera = CameraState{
+        .Position = m_Camera.getPosition(),
+        .Front = m_Camera.getFront(),
+        .Up = m_Camera.getUp(),
+    };
+
+    m_StartTime = Clock::now();
+    publishSnapshot(m_StartTime);
+    acquireSnapshot();
+}
+
+void Simulation::shutdown() {
+    m_Running = false;
+
+    if (m_Thread.joinable()) {
+        m_Thread.join();
+    }
+}
+
+void Simulation::start() {
+    assert(!m_Running);
+
+    m_Running = true;
+    m_StartTime = Clock::now();
+    m_Thread = std::thread(&Simulation::simulationLoop, this);
+}
+
+void Simulation::setMovement(std::uint32_t movement) {
+    m_Movement.store(movement, std::memory_order_relaxed);
+}
+
+void Simulation::addMouseMotion(float xOffset, float yOffset) {
+    m_MouseX.store(m_MouseX.load(std::memory_order_relaxed) + xOffset, std::memory_order_relaxed);
+    m_MouseY.store(m_MouseY.load(std::memory_order_relaxed) + yOffset, std::memory_order_relaxed);
+}
+
+const SimulationSnapshot &Simulation::acquireSnapshot() {
+    m_Snapshots.acquire();
+    return m_Snapshots.getReadBuffer();
+}
+
+const SimulationSnapshot &Simulation::getSnapshot() const {
+    return m_Snapshots.getReadBuffer();
+}
+
+float Simulation::getInterpolationFactor(const SimulationSnapshot &snapshot) const {
+    const double alpha = (getTime(Clock::now()) - snapshot.Time) * m_TickRate;
+    return (float)std::clamp(alpha, 0.0, 1.0);
+}
+
+double Simulation::getTickRate() const {
+    return m_TickRate;
+}
+
+void Simulation::simulationLoop() {
+    Clock::time_point nextTick = m_StartTime + m_TickDuration;
+
+    while (m_Running.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_until(nextTick);
+
+        const Clock::time_point now = Clock::now();
+        for (std::uint32_t i = 0; i < SIMULATION_MAX_CATCH_UP_TICKS && nextTick <= now; i++) {
+            tick();
+            nextTick += m_TickDuration;
+        }
+
+        while (nextTick <= now) {
+            m_Stats.SkippedTickCount++;
+            nextTick += m_TickDuration;
+        }
+
+        publishSnapshot(nextTick - m_TickDuration);
+    }
+}
+
+void Simulation::tick() {
+    const Clock::time_point start = Clock::now();
+
+    m_PreviousCamera = CameraState{
+        .Position = m_Camera.getPosition(),
+        .Front = m_Camera.getFront(),
+        .Up = m_Camera.getUp(),
+    };
+    if (m_SceneGraph->getLastUpdatedCount() > 0) {
+        const std::span<const glm::mat4> previousWorldMatrices = m_SceneGraph->getWorldMatrices();
+        m_PreviousWorldMatrices.assign(previousWorldMatrices.begin(), previousWorldMatrices.end());
+    }
+
+    const std::uint32_t movement = m_Movement.load(std::memory_order_relaxed);
+    if (movement != 0) {
+        m_Camera.move((CameraMovement)movement, 1000.0f / (float)m_TickRate);
+    }
+    m_Camera.moveMouse(m_MouseX.load(std::memory_order_relaxed), m_MouseY.load(std::memory_order_relaxed));
+
+    m_SceneGraph->updateTransforms(m_JobSystem);
+
+    m_Tick++;
+
+    const float tickTime = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    m_Stats.TickCount++;
+    m_Stats.TickTime = tickTime;
+    m_Stats.AverageTickTime += (tickTime - m_Stats.AverageTickTime) / (float)m_Stats.TickCount;
+}
+
+void Simulation::publishSnapshot(Clock::time_point tickTime) {
+    SimulationSnapshot &snapshot = m_Snapshots.getWriteBuffer();
+    snapshot.Tick = m_Tick;
+    snapshot.Time = getTime(tickTime);
+
+    snapshot.PreviousCamera = m_PreviousCamera;
+    snapshot.Camera = CameraState{
+        .Position = m_Camera.getPosition(),
+        .Front = m_Camera.getFront(),
+        .Up = m_Camera.getUp(),
+    };
+
+    const std::span<const glm::mat4> worldMatrices = m_SceneGraph->getWorldMatrices();
+    snapshot.PreviousWorldMatrices.assign(m_PreviousWorldMatrices.begin(), m_PreviousWorldMatrices.end());
+    snapshot.WorldMatrices.assign(worldMatrices.begin(), worldMatrices.end());
+
+    snapshot.Stats = m_Stats;
+
+    m_Snapshots.publish();
+}
+
+double Simulation::getTime(Clock::time_point timePoint) const {
+    return std::chrono::duration<double>(timePoint - m_StartTime).count();
+}
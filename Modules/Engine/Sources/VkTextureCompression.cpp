@@ -0,0 +1,257 @@
+#include <VkGuide/VkTextureCompression.hpp>
+#include <VkGuide/VkUtils.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#define STB_DXT_IMPLEMENTATION
+#include <stb_dxt.h>
+
+static void downsample(const std::uint8_t *pixels, VkExtent2D extent, std::uint8_t *result, VkExtent2D halfExtent) {
+    for (std::uint32_t y = 0; y < halfExtent.height; y++) {
+        const std::uint32_t y0 = std::min(y * 2, extent.height - 1);
+        const std::uint32_t y1 = std::min(y * 2 + 1, extent.height - 1);
+
+        for (std::uint32_t x = 0; x < halfExtent.width; x++) {
+            const std::uint32_t x0 = std::min(x * 2, extent.width - 1);
+            const std::uint32_t x1 = std::min(x * 2 + 1, extent.width - 1);
+
+            for (std::uint32_t c = 0; c < 4; c++) {
+                const std::uint32_t sum = pixels[((std::size_t)y0 * extent.width + x0) * 4 + c] +
+                                          pixels[((std::size_t)y0 * extent.width + x1) * 4 + c] +
+                                          pixels[((std::size_t)y1 * extent.width + x0) * 4 + c] +
+                                          pixels[((std::size_t)y1 * extent.width + x1) * 4 + c];
+                result[((std::size_t)y * halfExtent.width + x) * 4 + c] = (std::uint8_t)((sum + 2) / 4);
+            }
+        }
+    }
+}
+
+static void compressBlocks(const std::uint8_t *pixels, VkExtent2D extent, VkFormat format, std::uint8_t *output) {
+    const std::uint32_t blockByteSize = vkutils::GetBlockByteSize(format);
+    const std::uint32_t blockCountX = (extent.width + 3) / 4;
+    const std::uint32_t blockCountY = (extent.height + 3) / 4;
+
+    std::array<std::uint8_t, 64> block{};
+    for (std::uint32_t blockY = 0; blockY < blockCountY; blockY++) {
+        for (std::uint32_t blockX = 0; blockX < blockCountX; blockX++) {
+            for (std::uint32_t y = 0; y < 4; y++) {
+                const std::uint32_t sourceY = std::min(blockY * 4 + y, extent.height - 1);
+
+                for (std::uint32_t x = 0; x < 4; x++) {
+                    const std::uint32_t sourceX = std::min(blockX * 4 + x, extent.width - 1);
+                    const std::uint8_t *texel = &pixels[((std::size_t)sourceY * extent.width + sourceX) * 4];
+
+                    if (format == VK_FORMAT_BC5_UNORM_BLOCK) {
+                        block[(y * 4 + x) * 2 + 0] = texel[0];
+                        block[(y * 4 + x) * 2 + 1] = texel[1];
+                    } else {
+                        std::memcpy(&block[(y * 4 + x) * 4], texel, 4);
+                    }
+                }
+            }
+
+            std::uint8_t *destination = output + ((std::size_t)blockY * blockCountX + blockX) * blockByteSize;
+            switch (format) {
+                case VK_FORMAT_BC5_UNORM_BLOCK:
+                    stb_compress_bc5_block(destination, block.data());
+                    break;
+                case VK_FORMAT_BC3_UNORM_BLOCK:
+                case VK_FORMAT_BC3_SRGB_BLOCK:
+                    stb_compress_dxt_block(destination, block.data(), 1, STB_DXT_HIGHQUAL);
+                    break;
+                default:
+                    stb_compress_dxt_block(destination, block.data(), 0, STB_DXT_HIGHQUAL);
+                    break;
+            }
+        }
+    }
+}
+
+namespace vkutils {
+    bool IsBlockCompressed(VkFormat format) {
+        return format >= VK_FORMAT_BC1_RGB_UNORM_BLOCK && format <= VK_FORMAT_BC7_SRGB_BLOCK;
+    }
+
+    bool IsSrgbFormat(VkFormat format) {
+        switch (format) {
+            case VK_FORMAT_R8G8B8A8_SRGB:
+            case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+            case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+            case VK_FORMAT_BC2_SRGB_BLOCK:
+            case VK_FORMAT_BC3_SRGB_BLOCK:
+            case VK_FORMAT_BC7_SRGB_BLOCK:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    std::uint32_t GetBlockByteSize(VkFormat format) {
+        switch (format) {
+            case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+            case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+            case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+            case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+            case VK_FORMAT_BC4_UNORM_BLOCK:
+            case VK_FORMAT_BC4_SNORM_BLOCK:
+                return 8;
+            case VK_FORMAT_BC2_UNORM_BLOCK:
+            case VK_FORMAT_BC2_SRGB_BLOCK:
+            case VK_FORMAT_BC3_UNORM_BLOCK:
+            case VK_FORMAT_BC3_SRGB_BLOCK:
+            case VK_FORMAT_BC5_UNORM_BLOCK:
+            case VK_FORMAT_BC5_SNORM_BLOCK:
+            case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+            case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+            case VK_FORMAT_BC7_UNORM_BLOCK:
+            case VK_FORMAT_BC7_SRGB_BLOCK:
+                return 16;
+            case VK_FORMAT_R8G8B8A8_UNORM:
+            case VK_FORMAT_R8G8B8A8_SRGB:
+                return 4;
+            default:
+                return 0;
+        }
+    }
+
+    VkDeviceSize GetLevelByteSize(VkFormat format, VkExtent2D extent) {
+        if (IsBlockCompressed(format)) {
+            return (VkDeviceSize)((extent.width + 3) / 4) * ((extent.height + 3) / 4) * GetBlockByteSize(format);
+        }
+        return (VkDeviceSize)extent.width * extent.height * GetBlockByteSize(format);
+    }
+
+    CompressedFormatSupport GetCompressedFormatSupport(VkPhysicalDevice physicalDevice, bool textureCompressionBC) {
+        if (!textureCompressionBC) return CompressedFormatSupport{};
+
+        auto isSupported = [physicalDevice](VkFormat format) {
+            VkFormatProperties properties{};
+            vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &properties);
+
+            const VkFormatFeatureFlags requiredFeatures = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_TRANSFER_DST_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+            return (properties.optimalTilingFeatures & requiredFeatures) == requiredFeatures;
+        };
+
+        return CompressedFormatSupport{
+            .BC1 = isSupported(VK_FORMAT_BC1_RGB_UNORM_BLOCK) && isSupported(VK_FORMAT_BC1_RGB_SRGB_BLOCK),
+            .BC3 = isSupported(VK_FORMAT_BC3_UNORM_BLOCK) && isSupported(VK_FORMAT_BC3_SRGB_BLOCK),
+            .BC5 = isSupported(VK_FORMAT_BC5_UNORM_BLOCK),
+            .BC7 = isSupported(VK_FORMAT_BC7_UNORM_BLOCK) && isSupported(VK_FORMAT_BC7_SRGB_BLOCK),
+        };
+    }
+
+    bool IsFormatSupported(const CompressedFormatSupport &support, VkFormat format) {
+        switch (format) {
+            case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+            case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+                return support.BC1;
+            case VK_FORMAT_BC3_UNORM_BLOCK:
+            case VK_FORMAT_BC3_SRGB_BLOCK:
+                return support.BC3;
+            case VK_FORMAT_BC5_UNORM_BLOCK:
+                return support.BC5;
+            case VK_FORMAT_BC7_UNORM_BLOCK:
+            case VK_FORMAT_BC7_SRGB_BLOCK:
+                return support.BC7;
+            case VK_FORMAT_R8G8B8A8_UNORM:
+            case VK_FORMAT_R8G8B8A8_SRGB:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    VkFormat SelectCompressedFormat(const CompressedFormatSupport &support, const DecodedTexture &texture, bool isNormalMap) {
+        if (isNormalMap) {
+            return support.BC5 ? VK_FORMAT_BC5_UNORM_BLOCK : VK_FORMAT_UNDEFINED;
+        }
+
+        const bool isSrgb = IsSrgbFormat(texture.Format);
+
+        bool hasAlpha = false;
+        for (std::size_t i = 3; i < texture.Pixels.size(); i += 4) {
+            if (texture.Pixels[i] != 0xFF) {
+                hasAlpha = true;
+                break;
+            }
+        }
+
+        if (hasAlpha) {
+            if (!support.BC3) return VK_FORMAT_UNDEFINED;
+            return isSrgb ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+        }
+
+        if (!support.BC1) return VK_FORMAT_UNDEFINED;
+        return isSrgb ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+    }
+
+    DecodedTexture GenerateMipChain(const DecodedTexture &texture) {
+        assert(texture.Levels.empty() && GetBlockByteSize(texture.Format) == 4);
+
+        DecodedTexture mipChain{
+            .Extent = texture.Extent,
+            .Format = texture.Format,
+        };
+
+        const std::uint32_t levelCount = GetMipLevelCount(texture.Extent);
+        mipChain.Levels.reserve(levelCount);
+
+        VkDeviceSize totalSize = 0;
+        VkExtent2D extent = texture.Extent;
+        for (std::uint32_t level = 0; level < levelCount; level++) {
+            const VkDeviceSize size = GetLevelByteSize(texture.Format, extent);
+            mipChain.Levels.emplace_back(TextureLevel{.Offset = totalSize, .Size = size, .Extent = extent});
+
+            totalSize += size;
+            extent = VkExtent2D{std::max(extent.width / 2, 1U), std::max(extent.height / 2, 1U)};
+        }
+
+        mipChain.Pixels.resize(totalSize);
+        std::memcpy(mipChain.Pixels.data(), texture.Pixels.data(), mipChain.Levels[0].Size);
+
+        for (std::uint32_t level = 1; level < levelCount; level++) {
+            const TextureLevel &source = mipChain.Levels[level - 1];
+            const TextureLevel &destination = mipChain.Levels[level];
+            downsample(mipChain.Pixels.data() + source.Offset, source.Extent, mipChain.Pixels.data() + destination.Offset, destination.Extent);
+        }
+
+        return mipChain;
+    }
+
+    std::optional<DecodedTexture> CompressTexture(const DecodedTexture &texture, VkFormat format) {
+        switch (format) {
+            case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+            case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+            case VK_FORMAT_BC3_UNORM_BLOCK:
+            case VK_FORMAT_BC3_SRGB_BLOCK:
+            case VK_FORMAT_BC5_UNORM_BLOCK:
+                break;
+            default:
+                fmt::println("[ERROR]: No CPU encoder for texture format {}.", string_VkFormat(format));
+                return std::nullopt;
+        }
+
+        const DecodedTexture mipChain = GenerateMipChain(texture);
+
+        DecodedTexture compressed{
+            .Extent = texture.Extent,
+            .Format = format,
+        };
+        compressed.Levels.reserve(mipChain.Levels.size());
+
+        VkDeviceSize totalSize = 0;
+        for (const TextureLevel &level : mipChain.Levels) {
+            const VkDeviceSize size = GetLevelByteSize(format, level.Extent);
+            compressed.Levels.emplace_back(TextureLevel{.Offset = totalSize, .Size = size, .Extent = level.Extent});
+            totalSize += size;
+        }
+        compressed.Pixels.resize(totalSize);
+
+        for (std::size_t level = 0; level < mipChain.Levels.size(); level++) {
+            compressBlocks(mipChain.Pixels.data() + mipChain.Levels[level].Offset, mipChain.Levels[level].Extent, format, compressed.Pixels.data() + compressed.Levels[level].Offset);
+        }
+
+        return compressed;
+    }
+}  // namespace vkutils
@@ -0,0 +1,369 @@
+#include <VkGuide/VkTextureStreaming.hpp>
+#include <VkGuide/VkBarriers.hpp>
+#include <VkGuide/VkBindless.hpp>
+#include <VkGuide/VkDeletionQueue.hpp>
+#include <VkGuide/VkInits.hpp>
+#include <VkGuide/VkMemoryTelemetry.hpp>
+#include <VkGuide/VkTextures.hpp>
+#include <VkGuide/VkUtils.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+void TextureStreamer::init(VkDevice device, VmaAllocator allocator, BindlessHeap *bindlessHeap, MemoryTelemetry *memoryTelemetry, ResourcePools *resourcePools, DeferredDeletionQueue *deletionQueue) {
+    m_Device = device;
+    m_Allocator = allocator;
+    m_BindlessHeap = bindlessHeap;
+    m_MemoryTelemetry = memoryTelemetry;
+    m_ResourcePools = resourcePools;
+    m_DeletionQueue = deletionQueue;
+}
+
+void TextureStreamer::destroy() {
+    for (StreamedTexture &texture : m_Textures) {
+        releaseImage(texture);
+    }
+
+    m_Textures.clear();
+    m_FreeTextures.clear();
+    m_ResidentBytes = 0;
+}
+
+std::uint32_t TextureStreamer::addTexture(DecodedTexture &&texture) {
+    assert(!texture.Levels.empty());
+
+    const std::uint32_t levelCount = (std::uint32_t)texture.Levels.size();
+
+    std::uint32_t tailLevel = levelCount - 1;
+    while (tailLevel > 0 && std::max(texture.Levels[tailLevel - 1].Extent.width, texture.Levels[tailLevel - 1].Extent.height) <= STREAMING_RESIDENT_EXTENT) {
+        tailLevel--;
+    }
+
+    StreamedTexture streamedTexture{
+        .Data = std::move(texture),
+        .Image = ImageHandle{},
+        .BindlessIndex = BINDLESS_INVALID_INDEX,
+        .ResidentLevel = levelCount,
+        .TailLevel = tailLevel,
+        .RequestedLevel = tailLevel,
+        .LastRequestedFrame = 0,
+    };
+
+    m_Stats.TextureCount++;
+
+    if (!m_FreeTextures.empty()) {
+        const std::uint32_t index = m_FreeTextures.back();
+        m_FreeTextures.pop_back();
+
+        m_Textures[index] = std::move(streamedTexture);
+        return index;
+    }
+
+    m_Textures.emplace_back(std::move(streamedTexture));
+    return (std::uint32_t)m_Textures.size() - 1;
+}
+
+void TextureStreamer::removeTexture(std::uint32_t textureIndex) {
+    StreamedTexture &texture = m_Textures[textureIndex];
+    if (texture.Data.Levels.empty()) return;
+
+    m_ResidentBytes -= getResidentSize(texture, texture.ResidentLevel);
+    releaseImage(texture);
+
+    texture = StreamedTexture{
+        .Data = DecodedTexture{},
+        .Image = ImageHandle{},
+        .BindlessIndex = BINDLESS_INVALID_INDEX,
+        .ResidentLevel = 0,
+        .TailLevel = 0,
+        .RequestedLevel = 0,
+        .LastRequestedFrame = 0,
+    };
+
+    m_FreeTextures.emplace_back(textureIndex);
+    m_Stats.TextureCount--;
+}
+
+void TextureStreamer::requestTexelDensity(std::uint32_t textureIndex, float uvDensity, float pixelsPerUnit) {
+    StreamedTexture &texture = m_Textures[textureIndex];
+    if (texture.Data.Levels.empty()) return;
+
+    const float texelsPerUnit = uvDensity * (float)std::max(texture.Data.Extent.width, texture.Data.Extent.height);
+    const float texelsPerPixel = texelsPerUnit / std::max(pixelsPerUnit, 1e-6f);
+
+    std::uint32_t level = 0;
+    if (texelsPerPixel > 1.0f) {
+        level = std::min((std::uint32_t)std::floor(std::log2(texelsPerPixel)), texture.TailLevel);
+    }
+
+    texture.RequestedLevel = std::min(texture.RequestedLevel, level);
+    texture.LastRequestedFrame = m_FrameNumber;
+}
+
+void TextureStreamer::update(VkCommandBuffer commandBuffer, std::uint64_t frameNumber, std::pmr::memory_resource *memory) {
+    const std::uint64_t requestFrame = m_FrameNumber;
+    m_FrameNumber = frameNumber;
+
+    m_Stats.BudgetBytes = queryBudget();
+    m_Stats.UploadCount = 0;
+    m_Stats.EvictionCount = 0;
+    m_Stats.UploadedBytes = 0;
+    m_Stats.EvictedBytes = 0;
+
+    std::pmr::vector<std::uint32_t> targetLevels(m_Textures.size(), memory);
+    std::pmr::vector<std::uint32_t> upgrades{memory};
+    std::pmr::vector<std::uint32_t> evictions{memory};
+
+    VkDeviceSize projectedBytes = m_ResidentBytes;
+    for (std::uint32_t i = 0; i < m_Textures.size(); i++) {
+        const StreamedTexture &texture = m_Textures[i];
+
+        targetLevels[i] = std::min(texture.ResidentLevel, texture.TailLevel);
+        projectedBytes += getResidentSize(texture, targetLevels[i]) - getResidentSize(texture, texture.ResidentLevel);
+
+        const bool isVisible = texture.LastRequestedFrame == requestFrame;
+        if (isVisible && texture.RequestedLevel < targetLevels[i]) {
+            upgrades.emplace_back(i);
+        } else if (targetLevels[i] < (isVisible ? texture.RequestedLevel : texture.TailLevel)) {
+            evictions.emplace_back(i);
+        }
+    }
+
+    std::sort(upgrades.begin(), upgrades.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return targetLevels[a] - m_Textures[a].RequestedLevel > targetLevels[b] - m_Textures[b].RequestedLevel;
+    });
+    std::sort(evictions.begin(), evictions.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return m_Textures[a].LastRequestedFrame < m_Textures[b].LastRequestedFrame;
+    });
+
+    std::size_t nextEviction = 0;
+    auto evict = [&]() {
+        if (nextEviction == evictions.size()) return false;
+
+        const std::uint32_t index = evictions[nextEviction++];
+        const StreamedTexture &texture = m_Textures[index];
+        const std::uint32_t level = texture.LastRequestedFrame == requestFrame ? texture.RequestedLevel : texture.TailLevel;
+
+        projectedBytes -= getResidentSize(texture, targetLevels[index]) - getResidentSize(texture, level);
+        targetLevels[index] = level;
+        return true;
+    };
+
+    while (projectedBytes > m_Stats.BudgetBytes && evict()) {
+    }
+
+    VkDeviceSize uploadBytes = 0;
+    for (std::uint32_t index : upgrades) {
+        const StreamedTexture &texture = m_Textures[index];
+        const VkDeviceSize size = getResidentSize(texture, texture.RequestedLevel);
+        const VkDeviceSize growth = size - getResidentSize(texture, targetLevels[index]);
+        if (uploadBytes > 0 && uploadBytes + size > STREAMING_MAX_UPLOAD_BYTES) continue;
+
+        while (projectedBytes + growth > m_Stats.BudgetBytes && evict()) {
+        }
+        if (projectedBytes + growth > m_Stats.BudgetBytes) break;
+
+        projectedBytes += growth;
+        uploadBytes += size;
+        targetLevels[index] = texture.RequestedLevel;
+    }
+
+    VkDeviceSize stagingSize = 0;
+    for (std::uint32_t i = 0; i < m_Textures.size(); i++) {
+        if (targetLevels[i] == m_Textures[i].ResidentLevel) continue;
+
+        stagingSize = (stagingSize + TEXTURE_STAGING_ALIGNMENT - 1) & ~(TEXTURE_STAGING_ALIGNMENT - 1);
+        stagingSize += getResidentSize(m_Textures[i], targetLevels[i]);
+    }
+
+    if (stagingSize > 0) {
+        VkBufferCreateInfo bufferInfo{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .size = stagingSize,
+            .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        };
+
+        VmaAllocationCreateInfo allocationInfo{
+            .flags = VMA_ALLOCATION_CREATE_MAPPED_BIT,
+            .usage = VMA_MEMORY_USAGE_CPU_ONLY,
+        };
+
+        AllocatedBuffer staging{};
+        VK_CHECK(vmaCreateBuffer(m_Allocator, &bufferInfo, &allocationInfo, &staging.Buffer, &staging.Allocation, &staging.Info));
+        m_MemoryTelemetry->track(staging.Allocation, MemoryCategory::Staging);
+
+        BarrierBuilder barriers{memory};
+        std::pmr::vector<ResidentUpload> uploads{memory};
+
+        VkDeviceSize offset = 0;
+        for (std::uint32_t i = 0; i < m_Textures.size(); i++) {
+            const StreamedTexture &texture = m_Textures[i];
+            if (targetLevels[i] == texture.ResidentLevel) continue;
+
+            offset = (offset + TEXTURE_STAGING_ALIGNMENT - 1) & ~(TEXTURE_STAGING_ALIGNMENT - 1);
+
+            const VkDeviceSize size = getResidentSize(texture, targetLevels[i]);
+            std::memcpy((char *)staging.Info.pMappedData + offset, texture.Data.Pixels.data() + texture.Data.Levels[targetLevels[i]].Offset, size);
+
+            AllocatedImage image = createResidentImage(texture, targetLevels[i]);
+            barriers.trackImage(image.Image, VK_IMAGE_ASPECT_COLOR_BIT, image.MipLevels);
+            barriers.transitionImage(image.Image, BARRIER_SCOPE_NONE, BARRIER_SCOPE_TRANSFER_WRITE, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+            uploads.emplace_back(ResidentUpload{
+                .Texture = i,
+                .Level = targetLevels[i],
+                .Image = image,
+                .StagingOffset = offset,
+            });
+            offset += size;
+        }
+        barriers.flush(commandBuffer);
+
+        for (const ResidentUpload &upload : uploads) {
+            copyResidentLevels(commandBuffer, m_Textures[upload.Texture], upload, staging.Buffer);
+            barriers.transitionImage(upload.Image.Image, BARRIER_SCOPE_TRANSFER_WRITE, BARRIER_SCOPE_SHADER_SAMPLED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        }
+        barriers.flush(commandBuffer);
+
+        for (const ResidentUpload &upload : uploads) {
+            makeResident(m_Textures[upload.Texture], upload.Level, upload.Image);
+        }
+
+        m_DeletionQueue->pushBuffer(staging, frameNumber);
+    }
+
+    m_Stats.FullyResidentCount = 0;
+    m_Stats.PendingCount = 0;
+    for (StreamedTexture &texture : m_Textures) {
+        if (texture.Data.Levels.empty()) continue;
+
+        m_Stats.FullyResidentCount += texture.ResidentLevel == 0 ? 1 : 0;
+        m_Stats.PendingCount += (texture.LastRequestedFrame == requestFrame && texture.RequestedLevel < texture.ResidentLevel) ? 1 : 0;
+        texture.RequestedLevel = texture.TailLevel;
+    }
+    m_Stats.ResidentBytes = m_ResidentBytes;
+}
+
+std::uint32_t TextureStreamer::getBindlessIndex(std::uint32_t texture) const {
+    return m_Textures[texture].BindlessIndex;
+}
+
+std::uint32_t TextureStreamer::getResidentLevel(std::uint32_t texture) const {
+    return m_Textures[texture].ResidentLevel;
+}
+
+const StreamingStats &TextureStreamer::getStats() const {
+    return m_Stats;
+}
+
+VkDeviceSize TextureStreamer::getResidentSize(const StreamedTexture &texture, std::uint32_t level) const {
+    if (level >= texture.Data.Levels.size()) return 0;
+    return texture.Data.Pixels.size() - texture.Data.Levels[level].Offset;
+}
+
+VkDeviceSize TextureStreamer::queryBudget() const {
+    const VkPhysicalDeviceMemoryProperties *memoryProperties = nullptr;
+    vmaGetMemoryProperties(m_Allocator, &memoryProperties);
+
+    std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets{};
+    vmaGetHeapBudgets(m_Allocator, budgets.data());
+
+    VkDeviceSize budget = 0;
+    VkDeviceSize usage = 0;
+    for (std::uint32_t heap = 0; heap < memoryProperties->memoryHeapCount; heap++) {
+        if ((memoryProperties->memoryHeaps[heap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) == 0) continue;
+
+        budget += budgets[heap].budget;
+        usage += budgets[heap].usage;
+    }
+
+    const VkDeviceSize available = (VkDeviceSize)((double)budget * STREAMING_BUDGET_USAGE);
+    const VkDeviceSize otherUsage = usage > m_ResidentBytes ? usage - m_ResidentBytes : 0;
+    return available > otherUsage ? available - otherUsage : 0;
+}
+
+AllocatedImage TextureStreamer::createResidentImage(const StreamedTexture &texture, std::uint32_t level) {
+    const TextureLevel &top = texture.Data.Levels[level];
+
+    AllocatedImage image{
+        .Extent = VkExtent3D{top.Extent.width, top.Extent.height, 1},
+        .Format = texture.Data.Format,
+        .MipLevels = (std::uint32_t)texture.Data.Levels.size() - level,
+    };
+
+    VkImageCreateInfo imageInfo = vkinit::GetImageCreateInfo(image.Format, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, image.Extent, image.MipLevels);
+
+    VmaAllocationCreateInfo allocationInfo{
+        .usage = VMA_MEMORY_USAGE_GPU_ONLY,
+        .requiredFlags = VkMemoryPropertyFlags(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+    };
+    VK_CHECK(vmaCreateImage(m_Allocator, &imageInfo, &allocationInfo, &image.Image, &image.Allocation, nullptr));
+    m_MemoryTelemetry->track(image.Allocation, MemoryCategory::Texture);
+
+    VkImageViewCreateInfo viewInfo = vkinit::GetImageViewCreateInfo(image.Format, image.Image, VK_IMAGE_ASPECT_COLOR_BIT, image.MipLevels);
+    VK_CHECK(vkCreateImageView(m_Device, &viewInfo, nullptr, &image.View));
+
+    return image;
+}
+
+void TextureStreamer::copyResidentLevels(VkCommandBuffer commandBuffer, const StreamedTexture &texture, const ResidentUpload &upload, VkBuffer stagingBuffer) const {
+    const std::span<const TextureLevel> levels = std::span<const TextureLevel>{texture.Data.Levels}.subspan(upload.Level);
+
+    std::vector<VkBufferImageCopy> copyRegions{};
+    copyRegions.reserve(levels.size());
+    for (std::uint32_t mip = 0; mip < levels.size(); mip++) {
+        copyRegions.emplace_back(VkBufferImageCopy{
+            .bufferOffset = upload.StagingOffset + levels[mip].Offset - levels[0].Offset,
+            .bufferRowLength = 0,
+            .bufferImageHeight = 0,
+            .imageSubresource = VkImageSubresourceLayers{
+                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                .mipLevel = mip,
+                .baseArrayLayer = 0,
+                .layerCount = 1,
+            },
+            .imageExtent = VkExtent3D{levels[mip].Extent.width, levels[mip].Extent.height, 1},
+        });
+    }
+
+    vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, upload.Image.Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, (std::uint32_t)copyRegions.size(), copyRegions.data());
+}
+
+void TextureStreamer::makeResident(StreamedTexture &texture, std::uint32_t level, const AllocatedImage &image) {
+    const std::uint32_t bindlessIndex = m_BindlessHeap->addSampledImage(image.View);
+    if (bindlessIndex == BINDLESS_INVALID_INDEX) {
+        // The heap is full, keep the current level rather than swap in an image no shader can index.
+        m_DeletionQueue->pushImage(image, m_FrameNumber);
+        return;
+    }
+
+    releaseImage(texture);
+
+    const VkDeviceSize previousSize = getResidentSize(texture, texture.ResidentLevel);
+    const VkDeviceSize size = getResidentSize(texture, level);
+
+    if (level < texture.ResidentLevel) {
+        m_Stats.UploadCount++;
+        m_Stats.UploadedBytes += size;
+    } else {
+        m_Stats.EvictionCount++;
+        m_Stats.EvictedBytes += previousSize - size;
+    }
+
+    m_ResidentBytes = m_ResidentBytes - previousSize + size;
+
+    texture.Image = m_ResourcePools->addImage(image);
+    texture.BindlessIndex = bindlessIndex;
+    texture.ResidentLevel = level;
+}
+
+void TextureStreamer::releaseImage(StreamedTexture &texture) {
+    if (!texture.Image.isValid()) return;
+
+    if (texture.BindlessIndex != BINDLESS_INVALID_INDEX) m_BindlessHeap->removeSampledImage(texture.BindlessIndex);
+    m_ResourcePools->releaseImage(texture.Image, m_FrameNumber);
+
+    texture.Image = ImageHandle{};
+    texture.BindlessIndex = BINDLESS_INVALID_INDEX;
+}
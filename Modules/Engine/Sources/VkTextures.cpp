@@ -0,0 +1,168 @@
+#include <VkGuide/VkTextures.hpp>
+#include <VkGuide/VkBindless.hpp>
+#include <VkGuide/VkKtx.hpp>
+#include <VkGuide/VkShaderArchive.hpp>
+
+#include <fstream>
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#define STBI_ONLY_JPEG
+#include <stb_image.h>
+
+std::size_t SamplerKeyHash::operator()(const SamplerKey &key) const {
+    std::size_t hash = 0;
+    auto combine = [&hash](std::size_t value) {
+        hash ^= value + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+    };
+
+    combine(key.MagFilter);
+    combine(key.MinFilter);
+    combine(key.MipmapMode);
+    combine(key.AddressModeU);
+    combine(key.AddressModeV);
+    combine(key.AddressModeW);
+    return hash;
+}
+
+static bool readFile(const std::filesystem::path &filePath, std::vector<std::uint8_t> &outBytes) {
+    std::ifstream file{filePath, std::ios::ate | std::ios::binary};
+    if (!file.is_open()) return false;
+
+    outBytes.resize(file.tellg());
+    file.seekg(0);
+    file.read((char *)outBytes.data(), outBytes.size());
+    return (bool)file;
+}
+
+static std::optional<DecodedTexture> decodeImage(const TextureSource &source, std::span<const std::uint8_t> bytes) {
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+
+    stbi_uc *pixels = stbi_load_from_memory(bytes.data(), (int)bytes.size(), &width, &height, &channels, STBI_rgb_alpha);
+    if (pixels == nullptr) {
+        fmt::println("[ERROR]: Failed to decode texture {}: {}.", source.Name, stbi_failure_reason());
+        return std::nullopt;
+    }
+
+    DecodedTexture texture{
+        .Pixels = std::vector<std::uint8_t>(pixels, pixels + (std::size_t)width * height * 4),
+        .Extent = VkExtent2D{(std::uint32_t)width, (std::uint32_t)height},
+        .Format = source.Format,
+    };
+    stbi_image_free(pixels);
+
+    return texture;
+}
+
+namespace vkutils {
+    std::optional<DecodedTexture> LoadTexture(const TextureSource &source, const CompressedFormatSupport &support) {
+        std::vector<std::uint8_t> fileBytes{};
+        std::span<const std::uint8_t> bytes = source.Bytes;
+        if (bytes.empty() && !source.FilePath.empty()) {
+            if (!readFile(source.FilePath, fileBytes)) {
+                fmt::println("[ERROR]: Failed to open file from path: {}.", source.FilePath.string());
+                return std::nullopt;
+            }
+            bytes = fileBytes;
+        }
+
+        if (bytes.empty()) {
+            fmt::println("[ERROR]: Texture {} has no supported data source.", source.Name);
+            return std::nullopt;
+        }
+
+        if (IsKtx2(bytes)) {
+            std::optional<DecodedTexture> texture = ReadKtx2(bytes);
+            if (texture.has_value() && !IsFormatSupported(support, texture->Format)) {
+                fmt::println("[ERROR]: Texture {} uses unsupported format {}.", source.Name, string_VkFormat(texture->Format));
+                return std::nullopt;
+            }
+            return texture;
+        }
+
+        std::filesystem::path cachePath{};
+        if (support.BC1 || support.BC3 || support.BC5) {
+            const std::uint64_t settings[]{TEXTURE_CACHE_VERSION, (std::uint64_t)source.Format, (std::uint64_t)source.IsNormalMap};
+            const std::uint64_t hash = HashBytes(settings, sizeof(settings), HashBytes(bytes.data(), bytes.size()));
+            cachePath = std::filesystem::path{TEXTURE_CACHE_DIRECTORY} / fmt::format("{:016x}.ktx2", hash);
+
+            std::vector<std::uint8_t> cachedBytes{};
+            if (std::filesystem::exists(cachePath) && readFile(cachePath, cachedBytes)) {
+                std::optional<DecodedTexture> texture = ReadKtx2(cachedBytes);
+                if (texture.has_value() && IsFormatSupported(support, texture->Format)) {
+                    texture->IsCached = true;
+                    return texture;
+                }
+            }
+        }
+
+        std::optional<DecodedTexture> texture = decodeImage(source, bytes);
+        if (!texture.has_value() || cachePath.empty()) return texture;
+
+        const VkFormat compressedFormat = SelectCompressedFormat(support, texture.value(), source.IsNormalMap);
+        if (compressedFormat == VK_FORMAT_UNDEFINED) return texture;
+
+        std::optional<DecodedTexture> compressed = CompressTexture(texture.value(), compressedFormat);
+        if (!compressed.has_value()) return texture;
+
+        std::error_code error{};
+        std::filesystem::create_directories(cachePath.parent_path(), error);
+        if (!error) WriteKtx2(cachePath, compressed.value());
+
+        return compressed;
+    }
+}  // namespace vkutils
+
+void SamplerCache::init(VkDevice device, BindlessHeap *bindlessHeap) {
+    m_Device = device;
+    m_BindlessHeap = bindlessHeap;
+}
+
+void SamplerCache::destroy() {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    for (const auto &[key, sampler] : m_Samplers) {
+        if (sampler.BindlessIndex != BINDLESS_INVALID_INDEX) m_BindlessHeap->removeSampler(sampler.BindlessIndex);
+        vkDestroySampler(m_Device, sampler.Sampler, nullptr);
+    }
+    m_Samplers.clear();
+}
+
+VkSampler SamplerCache::getSampler(const SamplerKey &key) {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    return getCachedSampler(key).Sampler;
+}
+
+std::uint32_t SamplerCache::getBindlessIndex(const SamplerKey &key) {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    return getCachedSampler(key).BindlessIndex;
+}
+
+const SamplerCache::CachedSampler &SamplerCache::getCachedSampler(const SamplerKey &key) {
+    std::unordered_map<SamplerKey, CachedSampler, SamplerKeyHash>::const_iterator it = m_Samplers.find(key);
+    if (it != m_Samplers.end()) return it->second;
+
+    VkSamplerCreateInfo samplerInfo{
+        .sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+        .magFilter = key.MagFilter,
+        .minFilter = key.MinFilter,
+        .mipmapMode = key.MipmapMode,
+        .addressModeU = key.AddressModeU,
+        .addressModeV = key.AddressModeV,
+        .addressModeW = key.AddressModeW,
+        .minLod = 0.0f,
+        .maxLod = VK_LOD_CLAMP_NONE,
+    };
+
+    VkSampler sampler{VK_NULL_HANDLE};
+    VK_CHECK(vkCreateSampler(m_Device, &samplerInfo, nullptr, &sampler));
+
+    const std::uint32_t bindlessIndex = m_BindlessHeap->addSampler(sampler);
+    return m_Samplers.emplace(key, CachedSampler{.Sampler = sampler, .BindlessIndex = bindlessIndex}).first->second;
+}
+
+std::uint32_t SamplerCache::getSamplerCount() const {
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    return (std::uint32_t)m_Samplers.size();
+}
@@ -1,34 +1,10 @@
-#include <VkGuide/VkInits.hpp>
+#include <VkGuide/VkBarriers.hpp>
 #include <VkGuide/VkUtils.hpp>
 
-namespace vkutils {
-    void TransitionImageLayout(VkCommandBuffer commandBuffer, VkImage image, VkImageLayout currentLayout, VkImageLayout newLayout) {
-        VkImageAspectFlags aspectMask = (newLayout == VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL) ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
-
-        VkImageMemoryBarrier2 imageBarrier{
-            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
-
-            .srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
-            .srcAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT,
-            .dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
-            .dstAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT | VK_ACCESS_2_MEMORY_READ_BIT,
-
-            .oldLayout = currentLayout,
-            .newLayout = newLayout,
-
-            .image = image,
-            .subresourceRange = vkinit::GetImageSubresourceRange(aspectMask),
-        };
-
-        VkDependencyInfo dependencyInfo{
-            .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
-            .imageMemoryBarrierCount = 1,
-            .pImageMemoryBarriers = &imageBarrier,
-        };
-
-        vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
-    }
+#include <algorithm>
+#include <cmath>
 
+namespace vkutils {
     void CopyImageToImage(VkCommandBuffer commandBuffer, VkImage src, VkImage dst, VkExtent2D srcSize, VkExtent2D dstSize) {
         VkImageBlit2 blitRegion{
             .sType = VK_STRUCTURE_TYPE_IMAGE_BLIT_2,
@@ -65,4 +41,58 @@ namespace vkutils {
         };
         vkCmdBlitImage2(commandBuffer, &blitInfo);
     }
+
+    std::uint32_t GetMipLevelCount(VkExtent2D imageSize) {
+        return (std::uint32_t)std::floor(std::log2(std::max(imageSize.width, imageSize.height))) + 1;
+    }
+
+    void GenerateMipmaps(VkCommandBuffer commandBuffer, BarrierBuilder &barriers, VkImage image, VkExtent2D imageSize, std::uint32_t mipLevels) {
+        for (std::uint32_t mip = 0; mip < mipLevels; mip++) {
+            const VkExtent2D halfSize{
+                .width = std::max(imageSize.width / 2, 1U),
+                .height = std::max(imageSize.height / 2, 1U),
+            };
+
+            barriers.transitionImageMips(image, mip, 1, BARRIER_SCOPE_TRANSFER_WRITE, BARRIER_SCOPE_TRANSFER_READ, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL).flush(commandBuffer);
+
+            if (mip + 1 < mipLevels) {
+                VkImageBlit2 blitRegion{
+                    .sType = VK_STRUCTURE_TYPE_IMAGE_BLIT_2,
+                    .srcSubresource = VkImageSubresourceLayers{
+                        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                        .mipLevel = mip,
+                        .baseArrayLayer = 0,
+                        .layerCount = 1,
+                    },
+                    .srcOffsets = {
+                        VkOffset3D{0},
+                        VkOffset3D{.x = (std::int32_t)imageSize.width, .y = (std::int32_t)imageSize.height, .z = 1},
+                    },
+                    .dstSubresource = VkImageSubresourceLayers{
+                        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                        .mipLevel = mip + 1,
+                        .baseArrayLayer = 0,
+                        .layerCount = 1,
+                    },
+                    .dstOffsets = {
+                        VkOffset3D{0},
+                        VkOffset3D{.x = (std::int32_t)halfSize.width, .y = (std::int32_t)halfSize.height, .z = 1},
+                    },
+                };
+                VkBlitImageInfo2 blitInfo{
+                    .sType = VK_STRUCTURE_TYPE_BLIT_IMAGE_INFO_2,
+                    .srcImage = image,
+                    .srcImageLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                    .dstImage = image,
+                    .dstImageLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                    .regionCount = 1,
+                    .pRegions = &blitRegion,
+                    .filter = VK_FILTER_LINEAR,
+                };
+                vkCmdBlitImage2(commandBuffer, &blitInfo);
+
+                imageSize = halfSize;
+            }
+        }
+    }
 }  // namespace vkutils
\ No newline at end of file
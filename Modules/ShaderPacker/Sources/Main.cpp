@@ -0,0 +1,20 @@
+#include <VkGuide/VkShaderArchive.hpp>
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        fmt::println("Usage: ShaderPacker <output.pak> <shader.spv>...");
+        return 1;
+    }
+
+    std::vector<std::filesystem::path> shaderPaths{};
+    for (int i = 2; i < argc; i++) {
+        shaderPaths.emplace_back(argv[i]);
+    }
+
+    if (!ShaderArchive::Write(argv[1], shaderPaths)) {
+        return 1;
+    }
+
+    fmt::println("[INFO]: Packed {} shaders into {}.", shaderPaths.size(), argv[1]);
+    return 0;
+}